@@ -0,0 +1,134 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+	constexpr std::size_t ITERATIONS = 1000000;
+
+	struct Vec3 { float x, y, z; };
+	struct Vec4 { float x, y, z, w; };
+	struct Mat4 { Vec4 rows[4]; };
+
+	Vec3 MakeVec3() { return { 1.0f, 2.0f, 3.0f }; }
+	Vec4 MakeVec4() { return { 1.0f, 2.0f, 3.0f, 4.0f }; }
+
+	// an Any holds a buffer, a type and a pointer to the operations table shared by type
+	void BenchFootprint()
+	{
+		Bench::Section("footprint");
+		std::printf("%-56s %10zu bytes\n", "sizeof(Any)", sizeof(Reflect::Any));
+		std::printf("%-56s %10zu bytes\n", "sizeof(AnyRef)", sizeof(Reflect::AnyRef));
+		std::printf("%-56s %10zu bytes\n", "sizeof(BasicAny<32>)", sizeof(Reflect::BasicAny<32>));
+		std::printf("%-56s %10zu bytes\n", "sizeof(BasicAny<64>)", sizeof(Reflect::BasicAny<64>));
+	}
+
+	template <typename T>
+	void BenchCopyAndMove(const char *copyName, const char *moveName, const T &value)
+	{
+		Reflect::Any source(value);
+
+		Bench::Run(copyName, ITERATIONS, [&]()
+		{
+			Reflect::Any copy(source);
+			Bench::DoNotOptimize(copy);
+		});
+
+		Bench::Run(moveName, ITERATIONS, [&]()
+		{
+			Reflect::Any moved(std::move(source));
+			Bench::DoNotOptimize(moved);
+			source = std::move(moved);
+		});
+	}
+
+	void BenchThroughput()
+	{
+		Bench::Section("copy and move throughput");
+		BenchCopyAndMove("copy int", "move int", 42);
+		BenchCopyAndMove("copy double", "move double", 4.2);
+		BenchCopyAndMove("copy std::string (short)", "move std::string (short)", std::string("short"));
+		BenchCopyAndMove("copy std::string (heap)", "move std::string (heap)", std::string(100, 'x'));
+		BenchCopyAndMove("copy std::vector<int>", "move std::vector<int>", std::vector<int>(100, 1));
+
+		std::vector<Reflect::Any> anys(1000, Reflect::Any(42));
+
+		Bench::Run("copy vector<Any> of 1000 int", ITERATIONS / 1000, [&]()
+		{
+			std::vector<Reflect::Any> copy(anys);
+			Bench::DoNotOptimize(copy);
+		});
+	}
+
+	// the payload is moved in and out of the Any: the allocations reported are the Any's own heap spills
+	template <std::size_t SIZE, typename T>
+	void BenchSpills(const char *name, T payload)
+	{
+		Bench::Run(name, ITERATIONS, [&]()
+		{
+			Reflect::BasicAny<SIZE> any(std::move(payload));
+			payload = std::move(*any.template TryCast<T>());
+			Bench::DoNotOptimize(any);
+		});
+	}
+
+	template <std::size_t SIZE>
+	void BenchSpillsWithSize()
+	{
+		char title[64];
+		std::snprintf(title, sizeof(title), "heap spills, SBO of %zu bytes (sizeof %zu)", SIZE, sizeof(Reflect::BasicAny<SIZE>));
+		Bench::Section(title);
+
+		BenchSpills<SIZE>("int", 42);
+		BenchSpills<SIZE>("double", 4.2);
+		BenchSpills<SIZE>("std::string", std::string(100, 'x'));
+		BenchSpills<SIZE>("std::vector<int>", std::vector<int>(100, 1));
+		BenchSpills<SIZE>("Vec3", MakeVec3());
+		BenchSpills<SIZE>("Vec4", MakeVec4());
+		BenchSpills<SIZE>("Mat4", Mat4{});
+	}
+
+	// results are returned in the default Any (its SBO size is set with -DREFLECT_ANY_SIZE)
+	void BenchReturnedAny()
+	{
+		Bench::Section("returned Any (default SBO)");
+
+		const Reflect::Function &makeVec3 = *Reflect::Resolve<Vec3>()->GetMemberFunction("Make");
+		const Reflect::Function &makeVec4 = *Reflect::Resolve<Vec4>()->GetMemberFunction("Make");
+
+		Bench::Run("Invoke returning Vec3", ITERATIONS, [&]()
+		{
+			Reflect::Any result = makeVec3.Invoke(Reflect::AnyRef());
+			Bench::DoNotOptimize(result);
+		});
+
+		Bench::Run("Invoke returning Vec4", ITERATIONS, [&]()
+		{
+			Reflect::Any result = makeVec4.Invoke(Reflect::AnyRef());
+			Bench::DoNotOptimize(result);
+		});
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<double>("double");
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<std::vector<int>>("vector<int>");
+	Reflect::Reflect<Vec3>("Vec3").AddMemberFunction(&MakeVec3, "Make");
+	Reflect::Reflect<Vec4>("Vec4").AddMemberFunction(&MakeVec4, "Make");
+	Reflect::Reflect<Mat4>("Mat4");
+
+	BenchFootprint();
+	BenchThroughput();
+	BenchSpillsWithSize<sizeof(void*)>();
+	BenchSpillsWithSize<16>();
+	BenchSpillsWithSize<32>();
+	BenchSpillsWithSize<64>();
+	BenchReturnedAny();
+}
@@ -0,0 +1,140 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+/*
+* minimal benchmark harness: Run times a body over a number of iterations and reports
+* the time and the heap allocations per iteration, allocations are counted by replacing
+* the global operator new, every benchmark is a single translation unit including this header
+*/
+
+namespace Bench
+{
+
+	inline std::atomic<std::uint64_t> &GetAllocationCounter()
+	{
+		static std::atomic<std::uint64_t> allocations{ 0 };
+
+		return allocations;
+	}
+
+	inline std::uint64_t GetAllocations()
+	{
+		return GetAllocationCounter().load(std::memory_order_relaxed);
+	}
+
+	// keeps the compiler from optimizing away a value computed by a benchmark
+	template <typename T>
+	inline void DoNotOptimize(const T &value)
+	{
+#if defined(__GNUC__) || defined(__clang__)
+		asm volatile("" : : "g"(&value) : "memory");
+#else
+		static const void *volatile sink;
+		sink = &value;
+#endif
+	}
+
+	inline double GetElapsed(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+	}
+
+	// prints the time (in ns) and the allocations of a benchmark per operation
+	inline void Report(const char *name, double elapsed, std::size_t operations, std::uint64_t allocations)
+	{
+		std::printf("%-56s %10.2f ns/op %8.3f allocs/op\n", name, elapsed / operations, static_cast<double>(allocations) / operations);
+	}
+
+	template <typename Body>
+	void Run(const char *name, std::size_t iterations, Body &&body)
+	{
+		for (std::size_t i = 0; i < iterations / 10 + 1; ++i)  // warm up caches and lazily built tables
+			body();
+
+		std::uint64_t allocations = GetAllocations();
+		auto start = std::chrono::steady_clock::now();
+
+		for (std::size_t i = 0; i < iterations; ++i)
+			body();
+
+		Report(name, GetElapsed(start), iterations, GetAllocations() - allocations);
+	}
+
+	// 1, 2, 4... up to the number of hardware threads (included)
+	inline std::vector<std::size_t> GetThreadCounts()
+	{
+		std::size_t maxThreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 4;
+		std::vector<std::size_t> threadCounts;
+
+		for (std::size_t threads = 1; threads < maxThreads; threads *= 2)
+			threadCounts.push_back(threads);
+
+		threadCounts.push_back(maxThreads);
+
+		return threadCounts;
+	}
+
+	inline void Section(const char *title)
+	{
+		std::printf("\n%s\n", title);
+	}
+
+	namespace Details
+	{
+
+		inline void *Allocate(std::size_t size, std::size_t alignment)
+		{
+			GetAllocationCounter().fetch_add(1, std::memory_order_relaxed);
+
+			if (size == 0)
+				size = 1;
+
+#ifdef _MSC_VER
+			void *memory = _aligned_malloc(size, alignment);
+#else
+			void *memory = std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+#endif
+
+			if (!memory)
+				throw std::bad_alloc();
+
+			return memory;
+		}
+
+		inline void Deallocate(void *memory)
+		{
+#ifdef _MSC_VER
+			_aligned_free(memory);
+#else
+			std::free(memory);
+#endif
+		}
+
+	}  // namespace Details
+
+}  // namespace Bench
+
+void *operator new(std::size_t size) { return Bench::Details::Allocate(size, alignof(std::max_align_t)); }
+void *operator new[](std::size_t size) { return Bench::Details::Allocate(size, alignof(std::max_align_t)); }
+void *operator new(std::size_t size, std::align_val_t alignment) { return Bench::Details::Allocate(size, static_cast<std::size_t>(alignment)); }
+void *operator new[](std::size_t size, std::align_val_t alignment) { return Bench::Details::Allocate(size, static_cast<std::size_t>(alignment)); }
+void operator delete(void *memory) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete[](void *memory) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete(void *memory, std::size_t) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete[](void *memory, std::size_t) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete(void *memory, std::align_val_t) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete[](void *memory, std::align_val_t) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete(void *memory, std::size_t, std::align_val_t) noexcept { Bench::Details::Deallocate(memory); }
+void operator delete[](void *memory, std::size_t, std::align_val_t) noexcept { Bench::Details::Deallocate(memory); }
+
+#endif  // BENCH_H
@@ -0,0 +1,134 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <string>
+
+namespace
+{
+
+	constexpr std::size_t ITERATIONS = 1000000;
+
+	// deep hierarchy: Level<N> derives from Level<N - 1>
+	template <int N>
+	struct Level : Level<N - 1>
+	{
+		int value = N;
+	};
+
+	template <>
+	struct Level<0>
+	{
+		virtual ~Level() = default;  // polymorphic for the dynamic_cast baseline
+
+		int value = 0;
+	};
+
+	constexpr int DEPTH = 8;
+
+	// wide hierarchy: the base looked up is the last of many
+	template <int N>
+	struct Part
+	{
+		virtual ~Part() = default;
+
+		int value = N;
+	};
+
+	struct Wide : Part<0>, Part<1>, Part<2>, Part<3>, Part<4>, Part<5>, Part<6>, Part<7> {};
+
+	template <int N>
+	void RegisterLevels()
+	{
+		std::string name = "Level" + std::to_string(N);
+
+		if constexpr (N == 0)
+			Reflect::Reflect<Level<0>>(name);
+		else
+		{
+			RegisterLevels<N - 1>();
+			Reflect::Reflect<Level<N>>(name).template AddBase<Level<N - 1>>();
+		}
+	}
+
+	template <int BASE>
+	void BenchDeepCast()
+	{
+		Level<DEPTH> object;
+		Reflect::Any any = Reflect::AnyRef(object);
+		Level<0> *root = &object;
+		char name[64];
+
+		std::snprintf(name, sizeof(name), "TryCast %d levels up", DEPTH - BASE);
+		Bench::Run(name, ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(any.TryCast<Level<BASE>>());
+		});
+
+		if constexpr (BASE != 0)  // a cast to the static type compiles to nothing
+		{
+			std::snprintf(name, sizeof(name), "dynamic_cast from the root to Level%d (baseline)", BASE);
+			Bench::Run(name, ITERATIONS, [&]()
+			{
+				Bench::DoNotOptimize(dynamic_cast<Level<BASE>*>(root));
+			});
+		}
+	}
+
+	void BenchDeep()
+	{
+		Bench::Section("deep hierarchy");
+		BenchDeepCast<DEPTH>();
+		BenchDeepCast<DEPTH - 1>();
+		BenchDeepCast<DEPTH / 2>();
+		BenchDeepCast<0>();
+	}
+
+	void BenchWide()
+	{
+		Bench::Section("wide hierarchy");
+
+		Wide object;
+		Reflect::Any any = Reflect::AnyRef(object);
+		Part<0> *first = &object;
+
+		Bench::Run("TryCast to the first of 8 bases", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(any.TryCast<Part<0>>());
+		});
+
+		Bench::Run("TryCast to the last of 8 bases", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(any.TryCast<Part<7>>());
+		});
+
+		Bench::Run("dynamic_cast across to the last base (baseline)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(dynamic_cast<Part<7>*>(first));
+		});
+
+		Bench::Run("TryCast to an unrelated type (failure)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(any.TryCast<Level<0>>());
+		});
+	}
+
+}  // namespace
+
+int main()
+{
+	RegisterLevels<DEPTH>();
+
+	Reflect::Reflect<Part<0>>("Part0");
+	Reflect::Reflect<Part<1>>("Part1");
+	Reflect::Reflect<Part<2>>("Part2");
+	Reflect::Reflect<Part<3>>("Part3");
+	Reflect::Reflect<Part<4>>("Part4");
+	Reflect::Reflect<Part<5>>("Part5");
+	Reflect::Reflect<Part<6>>("Part6");
+	Reflect::Reflect<Part<7>>("Part7");
+	Reflect::Reflect<Wide>("Wide")
+		.AddBase<Part<0>>().AddBase<Part<1>>().AddBase<Part<2>>().AddBase<Part<3>>()
+		.AddBase<Part<4>>().AddBase<Part<5>>().AddBase<Part<6>>().AddBase<Part<7>>();
+
+	BenchDeep();
+	BenchWide();
+}
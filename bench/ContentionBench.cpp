@@ -0,0 +1,120 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+	constexpr std::size_t LOOKUPS_PER_THREAD = 200000;
+
+	struct Base { int x = 1; };
+	struct Middle : Base { int y = 2; };
+	struct Leaf : Middle { int z = 3; };
+
+	template <int N>
+	struct Numbered : Middle { int n = N; };
+
+	constexpr int TYPES_PER_ROUND = 32;
+
+	template <int FIRST, int... N>
+	void RegisterNumbered(std::integer_sequence<int, N...>)
+	{
+		(Reflect::Reflect<Numbered<FIRST + N>>("Numbered" + std::to_string(FIRST + N)).template AddBase<Middle>().AddDataMember(&Numbered<FIRST + N>::n, "n"), ...);
+	}
+
+	// the lookups of a reflection heavy loop: resolve by type and by name, find a member, cast to a base
+	void Lookup(const Leaf &leaf)
+	{
+		const Reflect::TypeDescriptor *leafType = Reflect::Resolve<Leaf>();
+
+		Bench::DoNotOptimize(leafType->GetDataMember("x"));
+		Bench::DoNotOptimize(Reflect::Resolve("Middle"));
+		Bench::DoNotOptimize(Reflect::Any(Reflect::AnyRef(leaf)).TryCast<const Base>());
+	}
+
+	// the readers start together and do the same number of lookups, the time reported is per lookup and per thread
+	template <typename Writer>
+	void BenchReaders(const char *name, std::size_t readerCount, Writer &&writer)
+	{
+		std::atomic<std::size_t> ready{ 0 };
+		std::atomic<bool> isStarted{ false };
+		std::vector<std::thread> threads;
+
+		for (std::size_t i = 0; i < readerCount; ++i)
+			threads.emplace_back([&]()
+			{
+				Leaf leaf;
+
+				++ready;
+				while (!isStarted)
+					std::this_thread::yield();
+
+				for (std::size_t j = 0; j < LOOKUPS_PER_THREAD; ++j)
+					Lookup(leaf);
+			});
+
+		while (ready != readerCount)
+			std::this_thread::yield();
+
+		auto start = std::chrono::steady_clock::now();
+		isStarted = true;
+		writer();
+
+		for (std::thread &thread : threads)
+			thread.join();
+
+		char title[64];
+		std::snprintf(title, sizeof(title), "%s, %zu readers", name, readerCount);
+		Bench::Report(title, Bench::GetElapsed(start), LOOKUPS_PER_THREAD, 0);
+	}
+
+	void BenchReadOnly()
+	{
+		Bench::Section("lookups, no registration");
+
+		for (std::size_t readers : Bench::GetThreadCounts())
+			BenchReaders("lookup", readers, []() {});
+	}
+
+	// each round the writer registers new types deriving from Middle and adds a member to Base, which invalidates the tables being read
+	template <int ROUND>
+	void BenchWhileRegistering(std::size_t readers)
+	{
+		BenchReaders("lookup while registering", readers, []()
+		{
+			std::uint64_t allocations = Bench::GetAllocations();
+			auto start = std::chrono::steady_clock::now();
+
+			RegisterNumbered<ROUND * TYPES_PER_ROUND>(std::make_integer_sequence<int, TYPES_PER_ROUND>());
+			Reflect::Reflect<Base>("Base").AddDataMember(&Base::x, "x" + std::to_string(ROUND));
+
+			Bench::Report("  registration of a type (concurrent with the lookups)", Bench::GetElapsed(start), TYPES_PER_ROUND, Bench::GetAllocations() - allocations);
+		});
+	}
+
+	template <std::size_t... ROUNDS>
+	void BenchReadWrite(std::index_sequence<ROUNDS...>)
+	{
+		Bench::Section("lookups while a writer registers types");
+
+		std::vector<std::size_t> threadCounts = Bench::GetThreadCounts();
+
+		((ROUNDS < threadCounts.size() ? BenchWhileRegistering<ROUNDS>(threadCounts[ROUNDS]) : void()), ...);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<Base>("Base").AddDataMember(&Base::x, "x");
+	Reflect::Reflect<Middle>("Middle").AddBase<Base>().AddDataMember(&Middle::y, "y");
+	Reflect::Reflect<Leaf>("Leaf").AddBase<Middle>().AddDataMember(&Leaf::z, "z");
+
+	BenchReadOnly();
+	BenchReadWrite(std::make_index_sequence<8>());  // up to 128 threads
+}
@@ -0,0 +1,142 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <functional>
+#include <string>
+
+namespace
+{
+
+	constexpr std::size_t ITERATIONS = 1000000;
+
+	struct Body
+	{
+		float x = 0.0f;
+
+		void Move(float dx) { x += dx; }
+		float GetX() const { return x; }
+	};
+
+	int Add(int a, int b) { return a + b; }
+
+	std::size_t Length(const std::string &s) { return s.size(); }
+
+	void BenchFreeFunction()
+	{
+		Bench::Section("free function int(int, int)");
+
+		const Reflect::Function &add = *Reflect::Resolve<int>()->GetMemberFunction("Add");
+		Reflect::Invoker<int(int, int)> invoker = add.Bind<int(int, int)>();
+		std::function<int(int, int)> function = &Add;
+		int (*volatile pointer)(int, int) = &Add;  // volatile: not inlined
+		int a = 1, b = 2;
+		double c = 2.0;
+		Reflect::Any result;
+		Reflect::AnyRef args[] = { Reflect::AnyRef(a), Reflect::AnyRef(b) };
+
+		Bench::Run("direct call through a function pointer (baseline)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(pointer(a, b));
+		});
+
+		Bench::Run("std::function (baseline)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(function(a, b));
+		});
+
+		Bench::Run("Invoker", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(invoker(a, b));
+		});
+
+		Bench::Run("Invoke", ITERATIONS, [&]()
+		{
+			Reflect::Any sum = add.Invoke(Reflect::AnyRef(), a, b);
+			Bench::DoNotOptimize(sum);
+		});
+
+		Bench::Run("InvokeInto (result reused)", ITERATIONS, [&]()
+		{
+			add.InvokeInto(Reflect::AnyRef(), result, a, b);
+			Bench::DoNotOptimize(result);
+		});
+
+		Bench::Run("InvokeInto with a converted argument (double to int)", ITERATIONS, [&]()
+		{
+			add.InvokeInto(Reflect::AnyRef(), result, a, c);
+			Bench::DoNotOptimize(result);
+		});
+
+		Bench::Run("InvokeInto with a Span<AnyRef> of arguments", ITERATIONS, [&]()
+		{
+			add.InvokeInto(Reflect::AnyRef(), result, Reflect::Span<Reflect::AnyRef>(args));
+			Bench::DoNotOptimize(result);
+		});
+	}
+
+	void BenchMemberFunction()
+	{
+		Bench::Section("member function void(float)");
+
+		const Reflect::Function &move = *Reflect::Resolve<Body>()->GetMemberFunction("Move");
+		Reflect::Invoker<void(Body&, float)> invoker = move.Bind<void(Body&, float)>();
+		Body body;
+		Body *volatile pointer = &body;
+		float dx = 0.5f;
+
+		Bench::Run("direct call (baseline)", ITERATIONS, [&]()
+		{
+			pointer->Move(dx);
+		});
+
+		Bench::Run("Invoker", ITERATIONS, [&]()
+		{
+			invoker(body, dx);
+		});
+
+		Bench::Run("Invoke", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(move.Invoke(body, dx));
+		});
+
+		Bench::DoNotOptimize(body);
+	}
+
+	// arguments are passed by reference: a string isn't copied into the call
+	void BenchReferenceArgument()
+	{
+		Bench::Section("free function size_t(const std::string&)");
+
+		const Reflect::Function &length = *Reflect::Resolve<std::string>()->GetMemberFunction("Length");
+		std::size_t (*volatile pointer)(const std::string&) = &Length;
+		std::string text(100, 'x');
+		Reflect::Any result;
+
+		Bench::Run("direct call through a function pointer (baseline)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(pointer(text));
+		});
+
+		Bench::Run("InvokeInto (result reused)", ITERATIONS, [&]()
+		{
+			length.InvokeInto(Reflect::AnyRef(), result, text);
+			Bench::DoNotOptimize(result);
+		});
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int").AddMemberFunction(&Add, "Add");
+	Reflect::Reflect<double>("double").AddConversion<int>();
+	Reflect::Reflect<float>("float");
+	Reflect::Reflect<std::size_t>("size_t");
+	Reflect::Reflect<std::string>("string").AddMemberFunction(&Length, "Length");
+	Reflect::Reflect<Body>("Body")
+		.AddMemberFunction(&Body::Move, "Move")
+		.AddMemberFunction(&Body::GetX, "GetX");
+
+	BenchFreeFunction();
+	BenchMemberFunction();
+	BenchReferenceArgument();
+}
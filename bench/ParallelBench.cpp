@@ -0,0 +1,68 @@
+#include "Parallel.hpp"
+#include "Bench.hpp"
+#include <vector>
+
+namespace
+{
+
+	constexpr std::size_t COUNT = 1 << 20;
+	constexpr std::size_t GRAIN_SIZE = 4096;
+	constexpr std::size_t REPETITIONS = 10;
+
+	struct Particle
+	{
+		float x = 1.0f, y = 1.0f, z = 1.0f;
+		float speed = 1.0f;
+
+		void Scale(float factor) { x *= factor; y *= factor; z *= factor; }
+	};
+
+	// the time reported is per object, compare it with the batch call made on the calling thread
+	template <typename Call>
+	void BenchCall(const char *name, Call &&call)
+	{
+		auto start = std::chrono::steady_clock::now();
+		std::uint64_t allocations = Bench::GetAllocations();
+
+		for (std::size_t i = 0; i < REPETITIONS; ++i)
+			call();
+
+		Bench::Report(name, Bench::GetElapsed(start), COUNT * REPETITIONS, Bench::GetAllocations() - allocations);
+	}
+
+	void BenchScaling()
+	{
+		std::vector<Particle> particles(COUNT);
+		Reflect::Span<Particle> objects(particles);
+		const Reflect::Function &scale = *Reflect::Resolve<Particle>()->GetMemberFunction("Scale");
+		const Reflect::DataMember &speed = *Reflect::Resolve<Particle>()->GetDataMember("speed");
+		char name[64];
+
+		Bench::Section("batch calls on the calling thread (baseline)");
+		BenchCall("InvokeBatch Scale", [&]() { scale.InvokeBatch(objects, {}, 1.0f); });
+
+		for (std::size_t threads : Bench::GetThreadCounts())
+		{
+			Reflect::ThreadPool pool(threads);
+
+			std::snprintf(name, sizeof(name), "%zu threads", threads);
+			Bench::Section(name);
+
+			BenchCall("ParallelInvoke Scale", [&]() { Reflect::ParallelInvoke(pool, GRAIN_SIZE, scale, objects, {}, 1.0f); });
+			BenchCall("ParallelSet speed", [&]() { Reflect::ParallelSet(pool, GRAIN_SIZE, speed, objects, Reflect::Any(2.0f)); });
+		}
+
+		Bench::DoNotOptimize(particles);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<float>("float");
+	Reflect::Reflect<Particle>("Particle")
+		.AddDataMember(&Particle::speed, "speed")
+		.AddMemberFunction(&Particle::Scale, "Scale");
+
+	BenchScaling();
+}
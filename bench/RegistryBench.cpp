@@ -0,0 +1,99 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+	constexpr std::size_t ITERATIONS = 1000000;
+	constexpr std::size_t TYPE_COUNT = 256;
+
+	template <std::size_t N>
+	struct Tag {};
+
+	template <std::size_t... Ns>
+	void RegisterTags(std::index_sequence<Ns...>)
+	{
+		(Reflect::Reflect<Tag<Ns>>("Tag" + std::to_string(Ns)), ...);
+	}
+
+	struct Fields
+	{
+		int position, rotation, scale, velocity, mass, health, armor, speed;
+	};
+
+	void BenchTypeLookup()
+	{
+		Bench::Section("type lookup among 256 registered types");
+
+		std::string name = "Tag" + std::to_string(TYPE_COUNT / 2);
+		Reflect::HashedName hashedName(name);
+		Reflect::TypeId id = Reflect::GetTypeId<Tag<TYPE_COUNT / 2>>();
+		std::string missing = "NotRegistered";
+
+		Bench::Run("Resolve<T>()", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(Reflect::Resolve<Tag<TYPE_COUNT / 2>>());
+		});
+
+		Bench::Run("Resolve(TypeId)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(Reflect::Resolve(id));
+		});
+
+		Bench::Run("Resolve(HashedName) (precomputed hash)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(Reflect::Resolve(hashedName));
+		});
+
+		Bench::Run("Resolve(std::string) (hashed per call)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(Reflect::Resolve(name));
+		});
+
+		Bench::Run("Resolve(std::string) of a missing type", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(Reflect::Resolve(missing));
+		});
+	}
+
+	void BenchMemberLookup()
+	{
+		Bench::Section("member lookup among 8 data members");
+
+		const Reflect::TypeDescriptor *type = Reflect::Resolve<Fields>();
+		static constexpr Reflect::HashedName speed("speed");
+
+		Bench::Run("GetDataMember(std::string_view)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(type->GetDataMember("speed"));
+		});
+
+		Bench::Run("GetDataMember(HashedName) (hashed at compile time)", ITERATIONS, [&]()
+		{
+			Bench::DoNotOptimize(type->GetDataMember(speed));
+		});
+	}
+
+}  // namespace
+
+int main()
+{
+	RegisterTags(std::make_index_sequence<TYPE_COUNT>());
+
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<Fields>("Fields")
+		.AddDataMember(&Fields::position, "position")
+		.AddDataMember(&Fields::rotation, "rotation")
+		.AddDataMember(&Fields::scale, "scale")
+		.AddDataMember(&Fields::velocity, "velocity")
+		.AddDataMember(&Fields::mass, "mass")
+		.AddDataMember(&Fields::health, "health")
+		.AddDataMember(&Fields::armor, "armor")
+		.AddDataMember(&Fields::speed, "speed");
+
+	BenchTypeLookup();
+	BenchMemberLookup();
+}
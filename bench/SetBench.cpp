@@ -0,0 +1,68 @@
+#include "Reflect.hpp"
+#include "Bench.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+	constexpr std::size_t ITERATIONS = 100000;
+
+	struct Mesh
+	{
+		std::string name;
+		std::vector<float> vertices;
+		std::vector<float> normals;
+
+		const std::vector<float> &GetNormals() const { return normals; }
+		void SetNormals(std::vector<float> value) { normals = std::move(value); }
+	};
+
+	// the value set by copy stays in the Any, the value set by move is moved back into the Any after each call
+	template <typename T>
+	void BenchSet(const char *copyName, const char *moveName, const char *member, T Mesh::*field, T value)
+	{
+		const Reflect::DataMember &dataMember = *Reflect::Resolve<Mesh>()->GetDataMember(member);
+		Mesh mesh;
+		Reflect::Any any(std::move(value));
+
+		Bench::Run(copyName, ITERATIONS, [&]()
+		{
+			dataMember.Set(mesh, any);
+		});
+
+		Bench::Run(moveName, ITERATIONS, [&]()
+		{
+			dataMember.Set(mesh, std::move(any));
+			*any.TryCast<T>() = std::move(mesh.*field);  // the Any keeps the moved from object
+		});
+	}
+
+	void BenchField()
+	{
+		Bench::Section("field");
+		BenchSet("Set std::string (10000 chars) by copy", "Set std::string (10000 chars) by move", "name", &Mesh::name, std::string(10000, 'x'));
+		BenchSet("Set std::vector<float> (10000) by copy", "Set std::vector<float> (10000) by move", "vertices", &Mesh::vertices, std::vector<float>(10000, 1.0f));
+	}
+
+	void BenchSetter()
+	{
+		Bench::Section("setter taking its argument by value");
+		BenchSet("Set std::vector<float> (10000) by copy", "Set std::vector<float> (10000) by move", "normals", &Mesh::normals, std::vector<float>(10000, 1.0f));
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<std::vector<float>>("vector<float>");
+	Reflect::Reflect<Mesh>("Mesh")
+		.AddDataMember(&Mesh::name, "name")
+		.AddDataMember(&Mesh::vertices, "vertices")
+		.AddDataMember<&Mesh::SetNormals, &Mesh::GetNormals>("normals");
+
+	BenchField();
+	BenchSetter();
+}
@@ -2,7 +2,11 @@
 #define META_ANY_H
 
 #include "TypeDescriptor.hpp"
+#include "AnyAllocator.hpp"
+#include "Span.hpp"
 #include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <type_traits>
 #include <utility>
 #include <string>
@@ -28,85 +32,226 @@ namespace Reflect
 		template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t)>
 		using AlignedStorageT = typename AlignedStorage<SIZE, ALIGNMENT>::Type;
 
+		/*
+		* table of type erased operations, a single static instance per type is shared by all the Any
+		* objects holding that type (whatever their SBO size): operations work on object addresses, 
+		* the Any decides whether the object lives in the SBO buffer or on the heap
+		*
+		* a null operation means the object can be copied with memcpy (Copy, Move)
+		* or its destructor does nothing (Destroy), i.e. for trivially copyable objects
+		*/
+		struct AnyOperations
+		{
+			void (*Copy)(void *to, const void *from);  // copy construct into uninitialized memory
+			void (*Move)(void *to, void *from);        // move construct into uninitialized memory and destroy source
+			void (*Destroy)(void *instance);
+			std::size_t Size;
+			std::size_t Alignment;
+			bool IsNothrowMovable;                     // objects whose move may throw are never stored in the SBO buffer
+		};
+
+		template <typename T>
+		struct AnyTypeTraits
+		{
+			static void Copy(void *to, const void *from)
+			{
+				new(to) T(*static_cast<const T*>(from));
+			}
+
+			static void Move(void *to, void *from)
+			{
+				T &instance = *static_cast<T*>(from);
+				new(to) T(std::move(instance));
+				instance.~T();
+			}
+
+			static void Destroy(void *instance)
+			{
+				static_cast<T*>(instance)->~T();
+			}
+
+			static constexpr AnyOperations Operations{ 
+				std::is_trivially_copyable_v<T> ? nullptr : &Copy,
+				std::is_trivially_copyable_v<T> ? nullptr : &Move,
+				std::is_trivially_destructible_v<T> ? nullptr : &Destroy,
+				sizeof(T), 
+				alignof(T),
+				std::is_nothrow_move_constructible_v<T>
+			};
+		};
+
 	}  // namespace Details
 
+	/*
+	* BadCastException stores the types involved in a failed cast, the message
+	* is only formatted when what() is called (throwing it doesn't allocate)
+	*/
 	class BadCastException : public std::exception
 	{
 	public:
+		BadCastException(const TypeDescriptor *retrieved, const TypeDescriptor *contained, const char *context = "")
+			: mRetrieved(retrieved), mContained(contained), mContext(context) {}
+
 		BadCastException(const std::string &retrieved, const std::string &contained, const std::string &msg = "")
-			: mMessage(msg + " wrong type from Get: tried to get " + retrieved + ", contained " + contained) {}
+			: mRetrieved(nullptr), mContained(nullptr), mContext(""), mMessage(msg + " wrong type from Get: tried to get " + retrieved + ", contained " + contained) {}
 
 		const char *what() const noexcept override
 		{
+			if (mMessage.empty())
+			{
+				try
+				{
+					mMessage = std::string(mContext) + " wrong type from Get: tried to get " + GetTypeName(mRetrieved) + ", contained " + GetTypeName(mContained);
+				}
+				catch (...)
+				{
+					return "wrong type from Get";
+				}
+			}
+
 			return mMessage.c_str();
 		}
 
+		const TypeDescriptor *GetRetrievedType() const { return mRetrieved; }
+		const TypeDescriptor *GetContainedType() const { return mContained; }
+
 	private:
-		std::string mMessage;
+		static std::string GetTypeName(const TypeDescriptor *type)
+		{
+			return type ? type->GetName() : std::string("nothing");
+		}
+
+		const TypeDescriptor *mRetrieved;
+		const TypeDescriptor *mContained;
+		const char *mContext;
+		mutable std::string mMessage;  // formatted on first call to what()
 	};
 
-	template <std::size_t>
+	/*
+	* the SBO size, alignment and allocator of the Any used throughout the library can be chosen 
+	* at build time (i.e. -DREFLECT_ANY_SIZE=32), Any objects with different SBO size, alignment
+	* and allocator can be copied, moved and converted into each other
+	*/
+#ifndef REFLECT_ANY_SIZE
+	#define REFLECT_ANY_SIZE sizeof(void*)
+#endif
+
+#ifndef REFLECT_ANY_ALIGNMENT
+	#define REFLECT_ANY_ALIGNMENT alignof(std::max_align_t)
+#endif
+
+#ifndef REFLECT_ANY_ALLOCATOR
+	#define REFLECT_ANY_ALLOCATOR HeapAllocator
+#endif
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t), typename Allocator = HeapAllocator>
 	class BasicAny;
 
-	using Any = BasicAny<sizeof(void*)>;
+	using Any = BasicAny<REFLECT_ANY_SIZE, REFLECT_ANY_ALIGNMENT, REFLECT_ANY_ALLOCATOR>;
+
+	namespace Details
+	{
+
+		template <typename T>
+		struct IsBasicAny : std::false_type {};
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		struct IsBasicAny<BasicAny<SIZE, ALIGNMENT, Allocator>> : std::true_type {};
+
+	}  // namespace Details
 
 	/*
 	* AnyRef is an object that contains a pointer to any other object
-	* but does not manage its lifetime
+	* but does not manage its lifetime; a view of a const object (or of a const Any)
+	* is const: it can only be cast to a const type
 	*/
 	class AnyRef
 	{
-		template <std::size_t> friend class BasicAny;
+		template <std::size_t, std::size_t, typename> friend class BasicAny;
 
 	public:
-		AnyRef() : mInstance(nullptr), mType(nullptr) {}
+		AnyRef() : mInstance(nullptr), mType(nullptr), mIsConst(false) {}
 
-		template <typename T, typename U = std::remove_cv_t<T>, typename = std::enable_if_t<!std::is_same_v<U, AnyRef>>>
-		AnyRef(T &object) : mInstance(&object), mType(Details::Resolve<U>()) {}
+		template <typename T, typename U = std::remove_cv_t<T>, typename = std::enable_if_t<!std::is_same_v<U, AnyRef> && !Details::IsBasicAny<U>::value>>
+		AnyRef(T &object) : mInstance(const_cast<U*>(&object)), mType(Details::Resolve<U>()), mIsConst(std::is_const_v<T>) {}
 
-		template <std::size_t SIZE>
-		AnyRef(BasicAny<SIZE> &any) : mInstance(any.mInstance), mType(any.mType) {}
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		AnyRef(BasicAny<SIZE, ALIGNMENT, Allocator> &any) : mInstance(any.Get()), mType(any.GetType()), mIsConst(any.IsConstRef()) {}
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		AnyRef(const BasicAny<SIZE, ALIGNMENT, Allocator> &any) : mInstance(const_cast<void*>(any.Get())), mType(any.GetType()), mIsConst(true) {}
+
+		void *Get() const { return mInstance; }  // the object of a const view must not be modified through the returned pointer
+		const TypeDescriptor *GetType() const { return mType; }
+		bool IsConst() const { return mIsConst; }
+
+		// nullptr if the object isn't a T (or derived from T) or if T isn't const and the view is
+		template <typename T>
+		T *TryCast() const;
 
 	private:
 		void *mInstance;
 		TypeDescriptor const *mType;
+		bool mIsConst;
 	};
 
-	template <std::size_t SIZE>
-	void swap(BasicAny<SIZE> &any1, BasicAny<SIZE> &any2)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void swap(BasicAny<SIZE, ALIGNMENT, Allocator> &any1, BasicAny<SIZE, ALIGNMENT, Allocator> &any2) noexcept
 	{
 		any1.Swap(any2);
 	}
 
 	/*
 	* Any acts as a container of an object of any kind, it either allocates the object dynamically 
-	* on the heap or uses a SBO optimization for objects whose size is less than SIZE
+	* with Allocator or uses a SBO optimization for objects whose size is less than SIZE
+	* and whose alignment is less than ALIGNMENT
 	*/
-	template <std::size_t SIZE>
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
 	class BasicAny
 	{
 		friend class AnyRef;
 
+		template <std::size_t, std::size_t, typename> friend class BasicAny;
+
 	public:
 		BasicAny();
 
-		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!std::is_same_v<U, BasicAny>>::type>
+		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!Details::IsBasicAny<U>::value>::type>
 		BasicAny(T &&object);
 
 		BasicAny(const BasicAny &other);
-		BasicAny(BasicAny &&other);
+		BasicAny(BasicAny &&other) noexcept;
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		BasicAny(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		BasicAny(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &&other);
 
 		BasicAny(AnyRef handle);
 
+		template <typename T, typename... Args>
+		explicit BasicAny(std::in_place_type_t<T>, Args&&... args);
+
 		~BasicAny();
 
-		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!std::is_same<U, BasicAny>::value>::type>
+		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!Details::IsBasicAny<U>::value>::type>
 		BasicAny &operator=(T &&object);
 
 		BasicAny &operator=(const BasicAny &other);
-		BasicAny &operator=(BasicAny &&other);
+		BasicAny &operator=(BasicAny &&other) noexcept;
 
-		void Swap(BasicAny &other);
+		void Swap(BasicAny &other) noexcept;
+
+		// destroy the contained object (if any) and construct a new one in place
+		template <typename T, typename... Args>
+		std::decay_t<T> &Emplace(Args&&... args);
+
+		// replace the contained object (if any) by the result of fun, destroyed only after fun returns (fun may read it)
+		template <typename T, typename F>
+		std::decay_t<T> &EmplaceInvoke(F &&fun);
+
+		void Reset();
 
 		explicit operator bool() const { return Get() != nullptr; }
 
@@ -125,149 +270,115 @@ namespace Reflect
 		template <typename T>
 		BasicAny TryConvert() const;
 
-		bool IsRef() const { return mCopy == nullptr; }  // check if it's a AnyRef
+		bool IsRef() const { return mOperations == nullptr; }  // check if it's a AnyRef
+		bool IsConstRef() const { return IsRef() && (reinterpret_cast<std::uintptr_t>(mType) & CONST_REF_TAG); }  // a view of a const object
 
 	private:
-		void *mInstance;
-		Details::AlignedStorageT<SIZE> mStorage;
-
-		const TypeDescriptor *mType;
-
-		typedef void *(*CopyFun)(void*, const void*);
-		typedef void *(*MoveFun)(void*, void*);
-		typedef void (*DestroyFun)(void*);
-
-		CopyFun mCopy;
-		MoveFun mMove;
-		DestroyFun mDestroy;
+		Details::AlignedStorageT<SIZE, ALIGNMENT> mStorage;  // holds the object (SBO) or a pointer to it (heap allocated object or AnyRef)
 
-		template <typename T, typename = std::void_t<> /* void */>
-		struct TypeTraits
-		{
-			template <typename... Args>
-			static void *New(void *storage, Args&&... args)
-			{
-				T *instance = new T(std::forward<Args>(args)...);
-				new(storage) T*(instance);
+		const TypeDescriptor *mType;                // tagged with CONST_REF_TAG for a view of a const object
+		const Details::AnyOperations *mOperations;  // nullptr for empty Any and AnyRef
 
-				return instance;
-			}
+		// type descriptors are at least pointer aligned, the lowest bit of mType marks a const view (keeps Any within 32 bytes)
+		static constexpr std::uintptr_t CONST_REF_TAG = 1U;
 
-			static void *Copy(void *to, const void *from)
-			{
-				T *instance = new T(*static_cast<const T*>(from));
-				new(to) T*(instance);
+		// objects in the SBO buffer are moved when the Any is moved: only those that can't throw are stored there (moving an Any never throws)
+		static constexpr bool IsInline(std::size_t size, std::size_t alignment, bool isNothrowMovable) { return size <= SIZE && alignment <= ALIGNMENT && isNothrowMovable; }
+		static bool IsInline(const Details::AnyOperations *operations) { return IsInline(operations->Size, operations->Alignment, operations->IsNothrowMovable); }
 
-				return instance;
-			}
+		template <typename T>
+		static constexpr bool IsInline() { return IsInline(sizeof(T), alignof(T), std::is_nothrow_move_constructible_v<T>); }
 
-			static void *Move(void *to, void *from)
-			{
-				T *instance = static_cast<T*>(from);
-				new(to) T*(instance);
+		template <typename T, typename Init>
+		void Construct(Init &&init);
 
-				return instance;
-			}
+		void Destroy();
 
-			static void Destroy(void *instance)
-			{
-				delete static_cast<T*>(instance);
-			}
-		};
+		static void *Allocate(const Details::AnyOperations *operations);
+		static void Deallocate(void *instance, const Details::AnyOperations *operations);
 
-		template <typename T>
-		struct TypeTraits<T, typename std::enable_if<sizeof(T) <= SIZE>::type>
-		{
-			template <typename... Args>
-			static void *New(void *storage, Args&&... args)
-			{
-				new(storage) T(std::forward<Args>(args)...);
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		void CopyFrom(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
 
-				return storage;
-			}
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		void MoveFrom(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
 
-			static void *Copy(void *to, const void *from)
-			{
-				new(to) T(*static_cast<const T*>(from));
+		void MoveStorage(void *to, void *from) const;
+	};
 
-				return to;
-			}
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny() : mType(nullptr), mOperations(nullptr)
+	{
+		new(&mStorage) void*(nullptr);
+	}
 
-			static void *Move(void *to, void *from)
-			{
-				T &instance = *static_cast<T*>(from);
-				new(to) T(std::move(instance));
-				instance.~T();
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename U, typename>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(T &&object) : mType(nullptr), mOperations(nullptr)
+	{
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<T>(object)); });
+	}
 
-				return to;
-			}
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename... Args>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(std::in_place_type_t<T>, Args&&... args) : mType(nullptr), mOperations(nullptr)
+	{
+		using U = std::decay_t<T>;
 
-			static void Destroy(void *instance)
-			{
-				static_cast<T*>(instance)->~T();
-			}
-		};
-	};
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<Args>(args)...); });
+	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE>::BasicAny() : mInstance(nullptr), mCopy(nullptr), mMove(nullptr), mDestroy(nullptr), mType(nullptr)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(const BasicAny &other) : mType(other.mType), mOperations(other.mOperations)
 	{
-		new(&mStorage) std::nullptr_t(nullptr);
+		CopyFrom(other);
 	}
 
-	template <std::size_t SIZE>
-	template <typename T, typename U, typename>
-	BasicAny<SIZE>::BasicAny(T &&object) : mCopy(TypeTraits<U>::Copy), mMove(TypeTraits<U>::Move), mDestroy(TypeTraits<U>::Destroy), mType(Details::Resolve<U>())
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(BasicAny &&other) noexcept : mType(other.mType), mOperations(other.mOperations)
 	{
-		mInstance = TypeTraits<U>::New(&mStorage, std::forward<T>(object));
+		MoveFrom(other);
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE>::BasicAny(const BasicAny &other) : mCopy(other.mCopy), mMove(other.mMove), mDestroy(other.mDestroy), mType(other.mType)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other) : mType(other.mType), mOperations(other.mOperations)
 	{
-		mInstance = other.mCopy ? other.mCopy(&mStorage, other.mInstance) : other.mInstance;
+		CopyFrom(other);
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE>::BasicAny(BasicAny &&other) : mCopy(other.mCopy), mMove(other.mMove), mDestroy(other.mDestroy), mType(other.mType)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &&other) : mType(other.mType), mOperations(other.mOperations)
 	{
-		if (other.mMove)
-		{
-			mInstance = other.mMove(&mStorage, other.mInstance);
-			other.mDestroy = nullptr;
-		}
-		else
-			mInstance = other.mInstance;
+		MoveFrom(other);
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE>::BasicAny(AnyRef handle) : BasicAny()
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(AnyRef handle)
+		: mType(reinterpret_cast<const TypeDescriptor*>(reinterpret_cast<std::uintptr_t>(handle.mType) | (handle.mIsConst ? CONST_REF_TAG : 0U))), mOperations(nullptr)
 	{
-		mInstance = handle.mInstance;
-		mType = handle.mType;
+		new(&mStorage) void*(handle.mInstance);
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE>::~BasicAny()
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::~BasicAny()
 	{
-		if (mDestroy)
-			mDestroy(mInstance);
+		Destroy();
 	}
 
-	template <std::size_t SIZE>
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
 	template <typename T, typename U, typename>
-	BasicAny<SIZE> &BasicAny<SIZE>::operator=(T &&object)
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(T &&object)
 	{
-		//Any temp(std::forward<T>(object));
-		//Swap(temp)
-
-		//return *this;
+		BasicAny temp(std::forward<T>(object));
+		Swap(temp);
 
-		return *this = BasicAny(std::forward<T>(object));
+		return *this;
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE> &BasicAny<SIZE>::operator=(const BasicAny &other)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(const BasicAny &other)
 	{
 		//Any temp(other);
 		//Swap(temp);
@@ -277,8 +388,8 @@ namespace Reflect
 		return *this = BasicAny(other);
 	}
 
-	template <std::size_t SIZE>
-	BasicAny<SIZE> &BasicAny<SIZE>::operator=(BasicAny &&other)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(BasicAny &&other) noexcept
 	{
 		BasicAny temp(std::move(other));
 		Swap(temp);
@@ -286,115 +397,410 @@ namespace Reflect
 		return *this;
 	}
 
-	template <std::size_t SIZE>
-	void BasicAny<SIZE>::Swap(BasicAny &other)
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Swap(BasicAny &other) noexcept
+	{
+		if (this == &other)
+			return;
+
+		Details::AlignedStorageT<SIZE, ALIGNMENT> temp;
+		MoveStorage(&temp, &mStorage);
+		other.MoveStorage(&mStorage, &other.mStorage);
+		MoveStorage(&other.mStorage, &temp);
+
+		std::swap(mType, other.mType);
+		std::swap(mOperations, other.mOperations);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename... Args>
+	std::decay_t<T> &BasicAny<SIZE, ALIGNMENT, Allocator>::Emplace(Args&&... args)
+	{
+		using U = std::decay_t<T>;
+
+		Reset();
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<Args>(args)...); });
+
+		return *static_cast<U*>(Get());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename F>
+	std::decay_t<T> &BasicAny<SIZE, ALIGNMENT, Allocator>::EmplaceInvoke(F &&fun)
+	{
+		using U = std::decay_t<T>;
+
+		// fun may read the contained object (i.e. a call whose argument is this Any), it's destroyed only after fun returns
+		if (!mOperations)
+		{
+			Reset();  // empty or AnyRef: nothing owned to destroy
+			Construct<U>([&](void *instance) { new(instance) U(std::forward<F>(fun)()); });  // guaranteed copy elision
+		}
+		else if constexpr (!IsInline<U>())
+		{
+			const Details::AnyOperations *operations = &Details::AnyTypeTraits<U>::Operations;
+			void *instance = Allocate(operations);
+
+			try
+			{
+				new(instance) U(std::forward<F>(fun)());  // constructed in its new storage, next to the contained object
+			}
+			catch (...)
+			{
+				Deallocate(instance, operations);
+				throw;
+			}
+
+			Destroy();
+
+			new(&mStorage) void*(instance);
+			mType = Details::Resolve<U>();
+			mOperations = operations;
+		}
+		else
+		{
+			U result(std::forward<F>(fun)());  // the storage is shared with the contained object: compute the result first
+
+			Reset();
+			Construct<U>([&](void *instance) { new(instance) U(std::move(result)); });  // inline objects can be moved
+		}
+
+		return *static_cast<U*>(Get());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Reset()
 	{
-		if (mMove && other.mMove)
+		Destroy();
+
+		new(&mStorage) void*(nullptr);
+		mType = nullptr;
+		mOperations = nullptr;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename Init>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Construct(Init &&init)
+	{
+		// the Any must be empty, type and operations are set after the object is constructed, so that it's still empty if construction throws
+		const Details::AnyOperations *operations = &Details::AnyTypeTraits<T>::Operations;
+
+		if constexpr (IsInline<T>())
 		{
-			Details::AlignedStorageT<SIZE> temp;
-			void *instanceTemp = mMove(&temp, mInstance);
-			mInstance = other.mMove(&mStorage, other.mInstance);
-			other.mInstance = mMove(&other.mStorage, instanceTemp);
+			try
+			{
+				init(static_cast<void*>(&mStorage));
+			}
+			catch (...)
+			{
+				new(&mStorage) void*(nullptr);
+				throw;
+			}
 		}
-		else if (mMove)
-			other.mInstance = mMove(&other.mStorage, mInstance);
-		else  if (other.mMove)
-			mInstance = other.mMove(&mStorage, other.mInstance);
 		else
-			mInstance = other.mInstance;
+		{
+			void *instance = Allocate(operations);
 
-		// const TypeDescriptor *typeTemp = mType;
-		// mType = other.mType;
-		// other.mType = typeTemp;
-		std::swap(mType, other.mType);
+			try
+			{
+				init(instance);
+			}
+			catch (...)
+			{
+				Deallocate(instance, operations);
+				throw;
+			}
+
+			new(&mStorage) void*(instance);
+		}
+
+		mType = Details::Resolve<T>();
+		mOperations = operations;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Destroy()
+	{
+		if (!mOperations)
+			return;
+
+		void *instance = Get();
+
+		if (mOperations->Destroy)
+			mOperations->Destroy(instance);
+
+		if (!IsInline(mOperations))
+			Deallocate(instance, mOperations);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void *BasicAny<SIZE, ALIGNMENT, Allocator>::Allocate(const Details::AnyOperations *operations)
+	{
+		REFLECT_COUNT_HEAP_SPILL();
+
+		return Allocator::Allocate(operations->Size, operations->Alignment);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Deallocate(void *instance, const Details::AnyOperations *operations)
+	{
+		Allocator::Deallocate(instance, operations->Size, operations->Alignment);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::CopyFrom(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other)
+	{
+		if (!mOperations)  // empty Any or AnyRef: copy the pointer
+		{
+			new(&mStorage) void*(const_cast<void*>(other.Get()));
+			return;
+		}
+
+		void *instance = &mStorage;
+
+		if (!IsInline(mOperations))
+			instance = Allocate(mOperations);
+
+		if (!mOperations->Copy)  // trivially copyable object: copy the bytes
+			std::memcpy(instance, other.Get(), mOperations->Size);
+		else
+		{
+			try
+			{
+				mOperations->Copy(instance, other.Get());
+			}
+			catch (...)
+			{
+				if (instance != &mStorage)
+					Deallocate(instance, mOperations);
+				throw;
+			}
+		}
+
+		if (instance != &mStorage)
+			new(&mStorage) void*(instance);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::MoveFrom(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other)
+	{
+		if (!mOperations)  // empty Any or AnyRef: copy the pointer
+		{
+			new(&mStorage) void*(other.Get());
+			return;
+		}
+
+		if constexpr (OTHER_SIZE == SIZE && OTHER_ALIGNMENT == ALIGNMENT && std::is_same_v<OtherAllocator, Allocator>)
+			other.MoveStorage(&mStorage, &other.mStorage);
+		else
+		{
+			bool otherIsInline = other.IsInline(mOperations);
+			void *otherInstance = other.Get();
+
+			if (!otherIsInline && !IsInline(mOperations) && std::is_same_v<OtherAllocator, Allocator>)  // steal the heap allocated object
+				new(&mStorage) void*(otherInstance);
+			else
+			{
+				void *instance = IsInline(mOperations) ? static_cast<void*>(&mStorage) : Allocate(mOperations);
 
-		// void (*copyTemp)(void *, const void *) = mCopy;
-		// mCopy = other.mCopy;
-		// other.mCopy = copyTemp;
-		std::swap(mCopy, other.mCopy);
+				if (!mOperations->Move)  // trivially copyable object: copy the bytes
+					std::memcpy(instance, otherInstance, mOperations->Size);
+				else
+					mOperations->Move(instance, otherInstance);
 
-		// void (*moveTemp)(void *, void *) = mMove;
-		// mMove = other.mMove;
-		// other.mMove = moveTemp;
-		std::swap(mMove, other.mMove);
+				if (!otherIsInline)
+					other.Deallocate(otherInstance, mOperations);
 
-		// void (*destroyTemp)(void *) = mDestroy;
-		// mDestroy = other.mDestroy;
-		// other.mDestroy = destroyTemp;
-		std::swap(mDestroy, other.mDestroy);
+				if (instance != &mStorage)
+					new(&mStorage) void*(instance);
+			}
+		}
+
+		// moved from Any is left empty
+		new(&other.mStorage) void*(nullptr);
+		other.mType = nullptr;
+		other.mOperations = nullptr;
 	}
 
-	template <std::size_t SIZE>
-	const TypeDescriptor *BasicAny<SIZE>::GetType() const
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::MoveStorage(void *to, void *from) const
 	{
-		return mType;
+		// empty Any, AnyRef, heap allocated or trivially copyable object: copy the bytes
+		if (!mOperations || !mOperations->Move || !IsInline(mOperations))
+			std::memcpy(to, from, sizeof(Details::AlignedStorageT<SIZE, ALIGNMENT>));
+		else
+			mOperations->Move(to, from);
 	}
 
-	template <std::size_t SIZE>
-	const void *BasicAny<SIZE>::Get() const
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	const TypeDescriptor *BasicAny<SIZE, ALIGNMENT, Allocator>::GetType() const
 	{
-		return mInstance;
+		return reinterpret_cast<const TypeDescriptor*>(reinterpret_cast<std::uintptr_t>(mType) & ~CONST_REF_TAG);
 	}
 
-	template <std::size_t SIZE>
-	void *BasicAny<SIZE>::Get()
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	const void *BasicAny<SIZE, ALIGNMENT, Allocator>::Get() const
+	{
+		if (mOperations && IsInline(mOperations))
+			return &mStorage;
+
+		return *reinterpret_cast<void* const*>(&mStorage);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void *BasicAny<SIZE, ALIGNMENT, Allocator>::Get()
 	{
 		return const_cast<void*>(static_cast<const BasicAny&>(*this).Get());
 		//return const_cast<void*>(std::as_const(*this).Get());
 	}
 
-	template <std::size_t SIZE>
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
 	template <typename T>
-	const T *BasicAny<SIZE>::TryCast() const
+	const T *BasicAny<SIZE, ALIGNMENT, Allocator>::TryCast() const
 	{
-		const TypeDescriptor *typeDesc = typeDesc = Details::Resolve<T>();
+		const TypeDescriptor *typeDesc = Details::Resolve<T>();
 		
 		void *casted = nullptr;
+		void *instance = const_cast<void*>(Get());
 
-		if (!*this)
+		if (!instance)
 			return static_cast<T const*>(casted);
 
-		if (typeDesc == mType)
-			casted = mInstance;
+		if (typeDesc == GetType())
+			casted = instance;
 		else
-		{
-			for (auto *base : mType->GetBases())
-				if (base->GetType() == typeDesc)
-					casted = base->Cast(mInstance);
-		}
+			casted = GetType()->Cast(instance, typeDesc);  // direct and indirect bases
 
 		return static_cast<T const*>(casted);
 	}
 
-	template <std::size_t SIZE>
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
 	template <typename T>
-	T *BasicAny<SIZE>::TryCast()
+	T *BasicAny<SIZE, ALIGNMENT, Allocator>::TryCast()
 	{
+		if (!std::is_const_v<T> && IsConstRef())  // a view of a const object can only be cast to a const type
+			return nullptr;
+
 		return const_cast<T*>(static_cast<const BasicAny&>(*this).TryCast<T>());
 		//return const_cast<T*>(std::as_const(*this).TryCast<T>());
 	}
 
-	template <std::size_t SIZE>
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
 	template <typename T>
-	BasicAny<SIZE> BasicAny<SIZE>::TryConvert() const
+	BasicAny<SIZE, ALIGNMENT, Allocator> BasicAny<SIZE, ALIGNMENT, Allocator>::TryConvert() const
 	{
 		BasicAny converted;
 
 		if (!*this)
 			return converted;
 
-		if (TypeDescriptor const *typeDesc = Details::Resolve<T>(); typeDesc == mType)
+		if (TypeDescriptor const *typeDesc = Details::Resolve<T>(); typeDesc == GetType())
 			converted = *this;
 		else
 		{
-			for (auto *conversion : mType->GetConversions())
+			for (auto *conversion : GetType()->GetConversions())
 				if (conversion->GetToType() == typeDesc)
-					converted = conversion->Convert(mInstance);
+					converted = conversion->Convert(Get());
 		}
 
 		return converted;
 	}
 
+	template <typename T>
+	T *AnyRef::TryCast() const
+	{
+		if ((!std::is_const_v<T> && mIsConst) || !mType)
+			return nullptr;
+
+		return static_cast<T*>(mType->Cast(mInstance, Details::Resolve<T>()));
+	}
+
+	namespace Details
+	{
+
+		/*
+		* returns a pointer to the argument if it's a T (or a type derived from T),
+		* otherwise converts it to a T in the converted argument's storage
+		*/
+		template <typename T>
+		T *CastOrConvert(AnyRef arg, Any &converted)
+		{
+			if (!arg.GetType())
+				return nullptr;
+
+			if (void *instance = arg.GetType()->Cast(arg.Get(), Resolve<T>()))
+				return static_cast<T*>(instance);
+
+			converted = Any(arg).TryConvert<T>();  // a converted temporary is created only if a conversion is needed
+
+			return converted.TryCast<T>();
+		}
+
+		/*
+		* a column of arguments (or objects) for a batch of calls, the i-th call uses the element at Data + i * Stride:
+		* a single argument shared by all the calls has stride 0, a column of AnyRef has no type (each element has its own type
+		* and constness); the elements of a const column must not be modified
+		*/
+		struct BatchColumn
+		{
+			const void *Data;
+			std::size_t Stride;
+			const TypeDescriptor *Type;
+			bool IsConst;
+		};
+
+		template <typename T>
+		BatchColumn MakeBatchColumn(Span<T> elements)
+		{
+			if constexpr (std::is_same_v<RawType<T>, AnyRef>)
+				return { elements.data(), sizeof(T), nullptr, false };
+			else
+				return { elements.data(), sizeof(T), Resolve<RawType<T>>(), std::is_const_v<T> };
+		}
+
+		// where a reflected call stores its returned value: an Any, raw storage for an object of the returned type or nowhere
+		struct ResultStorage
+		{
+			Any *Slot;
+			void *Raw;
+		};
+
+		template <typename Ret, typename F>
+		void StoreResult(const ResultStorage &result, F &&call)
+		{
+			using U = RawType<Ret>;
+
+			if constexpr (std::is_void_v<Ret>)
+			{
+				call();
+
+				if (result.Slot)
+					result.Slot->Reset();
+			}
+			else if (result.Raw)
+				new(result.Raw) U(call());  // a referenced object is copied
+			else if (!result.Slot)
+				call();
+			else if constexpr (std::is_reference_v<Ret>)
+				*result.Slot = AnyRef(call());
+			else if constexpr (std::is_move_assignable_v<U>)
+			{
+				if (result.Slot->GetType() == Resolve<U>() && !result.Slot->IsRef())
+					*static_cast<U*>(result.Slot->Get()) = call();  // reuse the object (and its storage) already in the slot
+				else
+					result.Slot->template EmplaceInvoke<U>(std::forward<F>(call));  // construct the returned object in place
+			}
+			else
+				result.Slot->template EmplaceInvoke<U>(std::forward<F>(call));
+		}
+
+	}  // namespace Details
+
+	// containers of Any (i.e. std::vector) move their elements when they grow instead of copying them
+	static_assert(std::is_nothrow_move_constructible_v<Any> && std::is_nothrow_move_assignable_v<Any>, "moving an Any must not throw");
+
 }  // namespace Reflect
 
 #endif  // META_ANY_H
\ No newline at end of file
@@ -0,0 +1,93 @@
+#ifndef ANY_ALLOCATOR_H
+#define ANY_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <memory_resource>
+
+namespace Reflect
+{
+
+	/*
+	* allocators used by Any for objects that don't fit in the SBO buffer:
+	* they are stateless (Any doesn't store them), memory is requested with
+	* the size and alignment of the contained object
+	*/
+
+	// allocates objects with global (aligned) operator new/delete
+	class HeapAllocator
+	{
+	public:
+		static void *Allocate(std::size_t size, std::size_t alignment)
+		{
+			return ::operator new(size, std::align_val_t(alignment));
+		}
+
+		static void Deallocate(void *memory, std::size_t size, std::size_t alignment)
+		{
+			::operator delete(memory, size, std::align_val_t(alignment));
+		}
+	};
+
+	/*
+	* allocates objects from the memory resource currently set on the calling thread (i.e. a
+	* std::pmr::monotonic_buffer_resource reset each frame or a std::pmr::unsynchronized_pool_resource),
+	* the resource is recorded in front of each allocation so that the object can be released from
+	* any thread, after the thread's resource has changed: the resource must outlive the objects
+	*/
+	class MemoryResourceAllocator
+	{
+	public:
+		static void SetMemoryResource(std::pmr::memory_resource *resource)
+		{
+			GetResource() = resource ? resource : std::pmr::get_default_resource();
+		}
+
+		static std::pmr::memory_resource *GetMemoryResource()
+		{
+			return GetResource();
+		}
+
+		static void *Allocate(std::size_t size, std::size_t alignment)
+		{
+			std::pmr::memory_resource *resource = GetResource();
+			std::size_t headerSize = GetHeaderSize(alignment);
+
+			unsigned char *memory = static_cast<unsigned char*>(resource->allocate(headerSize + size, GetHeaderAlignment(alignment)));
+			new(memory + headerSize - sizeof(std::pmr::memory_resource*)) std::pmr::memory_resource*(resource);
+
+			return memory + headerSize;
+		}
+
+		static void Deallocate(void *memory, std::size_t size, std::size_t alignment)
+		{
+			std::size_t headerSize = GetHeaderSize(alignment);
+			unsigned char *block = static_cast<unsigned char*>(memory) - headerSize;
+			std::pmr::memory_resource *resource = *reinterpret_cast<std::pmr::memory_resource**>(block + headerSize - sizeof(std::pmr::memory_resource*));
+
+			resource->deallocate(block, headerSize + size, GetHeaderAlignment(alignment));
+		}
+
+	private:
+		static std::pmr::memory_resource *&GetResource()
+		{
+			thread_local std::pmr::memory_resource *resource = std::pmr::get_default_resource();  // one resource per thread
+
+			return resource;
+		}
+
+		static constexpr std::size_t GetHeaderAlignment(std::size_t alignment)
+		{
+			return alignment > alignof(std::pmr::memory_resource*) ? alignment : alignof(std::pmr::memory_resource*);
+		}
+
+		// the header keeps the object aligned and stores the resource pointer right before it
+		static constexpr std::size_t GetHeaderSize(std::size_t alignment)
+		{
+			return sizeof(std::pmr::memory_resource*) > alignment ? sizeof(std::pmr::memory_resource*) : alignment;
+		}
+	};
+
+}  // namespace Reflect
+
+#endif  // ANY_ALLOCATOR_H
@@ -2,6 +2,9 @@
 #define BASE_H
 
 #include "TypeDescriptor.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
 
 namespace Reflect
 {
@@ -10,27 +13,51 @@ namespace Reflect
 	{
 	public:
 		const TypeDescriptor *GetType() const { return mType; }
+		const TypeDescriptor *GetParent() const { return mParent; }
+
+		bool IsVirtual() const { return mIsVirtual; }
+		std::ptrdiff_t GetOffset() const { return mOffset; }  // pointer adjustment from the derived to the base object (non virtual bases only)
 
 		virtual void *Cast(void *object) = 0;
 
 	protected:
-		Base(TypeDescriptor const *type, const TypeDescriptor *parent)
-			: mParent(parent), mType(type) {}
+		Base(TypeDescriptor const *type, const TypeDescriptor *parent, bool isVirtual, std::ptrdiff_t offset)
+			: mParent(parent), mType(type), mIsVirtual(isVirtual), mOffset(offset) {}
 
 	private:
 		const TypeDescriptor *mParent;
 		const TypeDescriptor *mType;
+
+		bool mIsVirtual;
+		std::ptrdiff_t mOffset;
 	};
 
 	template <typename B, typename D>
 	class BaseImpl : public Base
 	{
+	private:
+		// pointers to members of a virtual base can't be converted to pointers to members of the derived class
+		static constexpr bool IsVirtualBase = !std::is_convertible_v<int B::*, int D::*>;
+
 	public:
-		BaseImpl() : Base(Details::Resolve<B>(), Details::Resolve<D>()) {}
+		BaseImpl() : Base(Details::Resolve<B>(), Details::Resolve<D>(), IsVirtualBase, GetBaseOffset()) {}
 
 		void *Cast(void *object) override
 		{
-			return static_cast<B*>(object);
+			return static_cast<B*>(static_cast<D*>(object));
+		}
+
+	private:
+		static std::ptrdiff_t GetBaseOffset()
+		{
+			if constexpr (IsVirtualBase)  // the offset of a virtual base depends on the dynamic type of the object
+				return 0;
+			else
+			{
+				D *derived = reinterpret_cast<D*>(std::uintptr_t(0x1000) * alignof(D));  // the offset of a non virtual base is known statically, no object is accessed
+
+				return reinterpret_cast<char*>(static_cast<B*>(derived)) - reinterpret_cast<char*>(derived);
+			}
 		}
 	};
 
@@ -3,9 +3,12 @@
 
 #include <vector>
 #include <tuple>
+#include <array>
 #include "TypeDescriptor.hpp"
 #include "Any.hpp"
+#include "Span.hpp"
 #include "Conversion.hpp"
+#include "ConversionPlan.hpp"
 #include "Base.hpp"
 
 namespace Reflect
@@ -16,9 +19,8 @@ namespace Reflect
 		if (from == to)
 			return true;
 
-		for (auto *base : from->GetBases())
-			if (base->GetType() == to)
-				return true;
+		if (from->HasBase(to))
+			return true;
 
 		for (auto *conversion : from->GetConversions())
 			if (conversion->GetToType() == to)
@@ -32,22 +34,69 @@ namespace Reflect
 	public:
 		Any NewInstance(std::vector<Any> &args)
 		{
+			Any instance;
+
 			if (args.size() == mParamTypes.size())
-				return NewInstanceImpl(args);
+			{
+				std::vector<AnyRef> argRefs(args.begin(), args.end());
+
+				Dispatch(argRefs, { &instance, nullptr });
+			}
+
+			return instance;
+		}
+
+		// construct with arguments only known at run time (no intermediate container, the arguments aren't copied)
+		Any NewInstance(Span<AnyRef> args) const
+		{
+			Any instance;
+			NewInstanceInto(instance, args);
+
+			return instance;
+		}
+
+		bool NewInstanceInto(Any &instance, Span<AnyRef> args) const
+		{
+			if (args.size() == mParamTypes.size() && Dispatch(args, { &instance, nullptr }))
+				return true;
 
-			return Any();
+			instance.Reset();
+
+			return false;
 		}
 
 		template <typename... Args>
 		Any NewInstance(Args&&... args) const
 		{
-			if (sizeof...(Args) == mParamTypes.size())
-			{
-				auto argsAny = std::vector<Any>({ Any(std::forward<Args>(args))... });
-				return NewInstanceImpl(argsAny);
-			}
+			Any instance;
+			NewInstanceInto(instance, args...);
 
-			return Any();
+			return instance;
+		}
+
+		/*
+		* constructs the new object in instance, the object already held by instance is assigned
+		* (reusing its storage) if it's of the same type; returns false (and resets instance) if the object can't be constructed
+		*/
+		template <typename... Args>
+		bool NewInstanceInto(Any &instance, Args&&... args) const
+		{
+			if (NewInstanceWith({ &instance, nullptr }, args...))
+				return true;
+
+			instance.Reset();
+
+			return false;
+		}
+
+		/*
+		* constructs the new object in storage (uninitialized memory with the size and alignment of the object),
+		* type must be the type of the object; the caller owns the constructed object
+		*/
+		template <typename... Args>
+		bool NewInstanceInto(void *storage, const TypeDescriptor *type, Args&&... args) const
+		{
+			return type == mParent && NewInstanceWith({ nullptr, storage }, args...);
 		}
 
 		TypeDescriptor const *GetParent() const
@@ -74,11 +123,58 @@ namespace Reflect
 	protected:
 		Constructor(TypeDescriptor *parent, const std::vector<const TypeDescriptor*> &paramTypes) : mParent(parent), mParamTypes(paramTypes) {}
 
+		const Details::ConversionPlan *FindConversionPlan(Span<AnyRef> args) const
+		{
+			return mConversionPlans.Find(args, mParamTypes);
+		}
+
 	private:
-		virtual Any NewInstanceImpl(std::vector<Any> &args) const = 0;
+		template <typename... Args>
+		bool NewInstanceWith(const Details::ResultStorage &instance, Args&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size())
+				return false;
+
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);  // arguments are referenced, not copied
+
+			return Dispatch(argRefs, instance);
+		}
+
+		virtual bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const = 0;
+
+		bool Dispatch(Span<AnyRef> args, const Details::ResultStorage &instance) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			bool isSuccess = NewInstanceImpl(args, instance);
+			REFLECT_CALL_RESULT(scope, isSuccess);
+
+			return isSuccess;
+		}
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const Constructor *constructor = static_cast<const Constructor*>(metaObject);
+
+			stats.TypeName = constructor->mParent->GetName();
+			stats.Kind = "constructor";
+			stats.Description = "(";
+
+			for (std::size_t i = 0; i < constructor->mParamTypes.size(); ++i)
+				stats.Description += (i ? ", " : "") + constructor->mParamTypes[i]->GetName();
+
+			stats.Description += ")";
+		}
+#endif
 
 		TypeDescriptor *mParent;
 		std::vector<TypeDescriptor const*> mParamTypes;
+
+		mutable Details::ConversionPlanCache mConversionPlans;
+
+		REFLECT_STATS_ID(&Constructor::Describe)
 	};
 
 	template <typename Type, typename... Args>
@@ -88,22 +184,28 @@ namespace Reflect
 		ConstructorImpl() : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }) {}
 
 	private:
-		Any NewInstanceImpl(std::vector<Any> &args) const override
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const override
 		{
-			return NewInstanceImpl(args, std::make_index_sequence<sizeof...(Args)>());
+			return NewInstanceImpl(args, instance, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any NewInstanceImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-			if ((std::get<indices>(argsTuple) && ...))
-				return Type(*std::get<indices>(argsTuple)...);
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			return Any();
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
+
+			Details::StoreResult<Type>(instance, [&]() -> Type { return Type(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });  // construct the object in place
+
+			return true;
 		}
 	};
 
@@ -116,22 +218,28 @@ namespace Reflect
 		FreeFunConstructor(CtorFun ctorFun) : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }), mCtorFun(ctorFun) {}
 	
 	private:
-		Any NewInstanceImpl(std::vector<Any> &args) const override
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const override
 		{
-			return NewInstanceImpl(args, std::make_index_sequence<sizeof...(Args)>());
+			return NewInstanceImpl(args, instance, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any NewInstanceImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-			if ((std::get<indices>(argsTuple) && ...))
-				return mCtorFun(*std::get<indices>(argsTuple)...);
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			return Any();
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
+
+			Details::StoreResult<Type>(instance, [&]() -> Type { return mCtorFun(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });  // construct the returned object in place
+
+			return true;
 		}
 		
 		CtorFun mCtorFun;
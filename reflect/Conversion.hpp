@@ -13,15 +13,36 @@ namespace Reflect
 		const TypeDescriptor *GetFromType() const { return mFromType; }
 		const TypeDescriptor *GetToType() const { return mToType; }
 
-		virtual Any Convert(const void *object) const = 0;
+		Any Convert(const void *object) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+			REFLECT_COUNT_CONVERSION();
+
+			return ConvertImpl(object);
+		}
 
 	protected:
 		Conversion(const TypeDescriptor *from, const TypeDescriptor *to)
 			: mFromType(from), mToType(to) {}
 
 	private:
+		virtual Any ConvertImpl(const void *object) const = 0;
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const Conversion *conversion = static_cast<const Conversion*>(metaObject);
+
+			stats.TypeName = conversion->mFromType->GetName();
+			stats.Kind = "conversion";
+			stats.Description = "to " + conversion->mToType->GetName();
+		}
+#endif
+
 		const TypeDescriptor *mFromType;  // type to convert from
 		const TypeDescriptor *mToType;    // type to convert to
+
+		REFLECT_STATS_ID(&Conversion::Describe)
 	};
 
 	template <typename From, typename To>
@@ -30,10 +51,11 @@ namespace Reflect
 	public:
 		ConversionImpl() : Conversion(Details::Resolve<From>(), Details::Resolve<To>()) {}
 
-		Any Convert(const void *object) const override
+	private:
+		Any ConvertImpl(const void *object) const override
 		{
 			//return To(*static_cast<const From*>(object));
-			return static_cast<To>(*static_cast<const From*>(object));
+			return Any(std::in_place_type<To>, *static_cast<const From*>(object));
 		}
 	};
 
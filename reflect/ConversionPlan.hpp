@@ -0,0 +1,256 @@
+#ifndef CONVERSION_PLAN_H
+#define CONVERSION_PLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include "TypeDescriptor.hpp"
+#include "Any.hpp"
+#include "Conversion.hpp"
+#include "Span.hpp"
+
+namespace Reflect
+{
+
+	namespace Details
+	{
+
+		// how an argument of a given type reaches the type of a parameter
+		struct ArgCast
+		{
+			enum class Kind { Identity, Offset, Cast, Convert };
+
+			Kind CastKind;
+			std::ptrdiff_t Offset;          // pointer adjustment to a base at a fixed offset
+			const TypeDescriptor *From;     // argument type (base reached through a virtual base)
+			const TypeDescriptor *To;       // parameter type
+			const Conversion *ToConversion;
+
+			void *Apply(void *arg, Any &converted) const
+			{
+				switch (CastKind)
+				{
+				case Kind::Identity:
+					return arg;
+				case Kind::Offset:
+					return static_cast<char*>(arg) + Offset;
+				case Kind::Cast:
+					return From->Cast(arg, To);
+				default:
+					converted = ToConversion->Convert(arg);  // a converted temporary is created only if a conversion is needed
+					return converted.Get();
+				}
+			}
+		};
+
+		// the casts of the arguments of a call, for a given list of argument types
+		struct ConversionPlan
+		{
+			std::vector<const TypeDescriptor*> ArgTypes;
+			std::vector<ArgCast> Casts;
+			bool IsFailed = false;         // an argument can't be cast nor converted
+			std::uint64_t Generation = 0;  // casts generation a failed plan was built in
+
+			bool Matches(Span<AnyRef> args) const
+			{
+				for (std::size_t i = 0; i < args.size(); ++i)
+					if (args[i].GetType() != ArgTypes[i])
+						return false;
+
+				return true;
+			}
+		};
+
+		/*
+		* cache of the conversion plans of a function or constructor: a call whose argument types
+		* match a recently used plan skips the search through bases and conversions (lock free),
+		* otherwise the plan is looked up or built under a lock; plans are kept until the cache is destroyed.
+		* Calls that can't be cast or converted are cached as failed plans, dropped once a base or a conversion
+		* is registered (the casts generation changes)
+		*/
+		class ConversionPlanCache
+		{
+		public:
+			// nullptr if the arguments can't be cast or converted to the parameters
+			const ConversionPlan *Find(Span<AnyRef> args, Span<const TypeDescriptor* const> paramTypes)
+			{
+				for (auto &recent : mRecentPlans)
+					if (const ConversionPlan *plan = recent.load(std::memory_order_acquire); plan && plan->Matches(args) && !IsStale(plan))
+						return plan->IsFailed ? nullptr : plan;
+
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				const ConversionPlan *plan = nullptr;
+
+				for (auto it = mPlans.begin(); it != mPlans.end(); ++it)
+					if ((*it)->Matches(args))
+					{
+						if (IsStale(it->get()))
+						{
+							Retire(it);
+							break;
+						}
+
+						plan = it->get();
+						break;
+					}
+
+				if (!plan)
+				{
+					std::uint64_t generation = GetCastsGeneration().load(std::memory_order_acquire);  // read before the casts are looked up
+					std::unique_ptr<ConversionPlan> built = Build(args, paramTypes);
+
+					built->Generation = generation;
+					plan = built.get();
+					mPlans.push_back(std::move(built));
+				}
+
+				mRecentPlans[mNextRecent++ % RECENT_PLANS].store(plan, std::memory_order_release);
+
+				return plan->IsFailed ? nullptr : plan;
+			}
+
+		private:
+			static bool IsStale(const ConversionPlan *plan)
+			{
+				return plan->IsFailed && plan->Generation != GetCastsGeneration().load(std::memory_order_acquire);
+			}
+
+			// stale plans are kept alive for readers that may still be matching them (mMutex must be held)
+			void Retire(std::vector<std::unique_ptr<ConversionPlan>>::iterator stale)
+			{
+				for (auto &recent : mRecentPlans)
+					if (recent.load(std::memory_order_relaxed) == stale->get())
+						recent.store(nullptr, std::memory_order_release);
+
+				mRetiredPlans.push_back(std::move(*stale));
+				mPlans.erase(stale);
+			}
+
+			static std::unique_ptr<ConversionPlan> Build(Span<AnyRef> args, Span<const TypeDescriptor* const> paramTypes)
+			{
+				auto plan = std::make_unique<ConversionPlan>();
+
+				for (std::size_t i = 0; i < args.size(); ++i)
+				{
+					const TypeDescriptor *from = args[i].GetType();
+					const TypeDescriptor *to = paramTypes[i];
+
+					plan->ArgTypes.push_back(from);
+
+					if (!from)
+					{
+						plan->IsFailed = true;
+						continue;
+					}
+
+					ArgCast argCast{ ArgCast::Kind::Identity, 0, from, to, nullptr };
+
+					if (from != to)
+					{
+						if (const BaseCast *baseCast = from->FindBaseCast(to))
+						{
+							argCast.CastKind = baseCast->Step ? ArgCast::Kind::Cast : ArgCast::Kind::Offset;
+							argCast.Offset = baseCast->Offset;
+						}
+						else
+						{
+							for (auto *conversion : from->GetConversions())
+								if (conversion->GetToType() == to)
+									argCast.ToConversion = conversion;
+
+							if (!argCast.ToConversion)
+							{
+								plan->IsFailed = true;
+								continue;
+							}
+
+							argCast.CastKind = ArgCast::Kind::Convert;
+						}
+					}
+
+					plan->Casts.push_back(argCast);
+				}
+
+				return plan;
+			}
+
+			static constexpr std::size_t RECENT_PLANS = 4;
+
+			std::array<std::atomic<const ConversionPlan*>, RECENT_PLANS> mRecentPlans{};
+			std::size_t mNextRecent = 0;  // guarded by mMutex
+			std::mutex mMutex;
+			std::vector<std::unique_ptr<ConversionPlan>> mPlans;
+			std::vector<std::unique_ptr<ConversionPlan>> mRetiredPlans;  // failed plans dropped after new casts were registered
+		};
+
+		// the argument as an object of type (cast to it or converted to it in converted), nullptr if it's neither
+		inline const void *CastOrConvert(AnyRef arg, const TypeDescriptor *type, Any &converted)
+		{
+			if (!arg.GetType())
+				return nullptr;
+
+			if (const void *instance = arg.GetType()->Cast(arg.Get(), type))
+				return instance;
+
+			for (auto *conversion : arg.GetType()->GetConversions())
+				if (conversion->GetToType() == type)
+				{
+					converted = conversion->Convert(arg.Get());
+
+					return converted.Get();
+				}
+
+			return nullptr;
+		}
+
+		// a parameter through which the argument can be modified
+		template <typename T>
+		struct IsMutableReference : std::bool_constant<std::is_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>> {};
+
+		/*
+		* passes a (referenced or converted) argument to a parameter: as an rvalue to a T&& parameter, as an lvalue
+		* otherwise (a parameter taken by value receives a copy, the argument itself is never moved from)
+		*/
+		template <typename Param, typename T>
+		decltype(auto) PassArg(T &arg)
+		{
+			if constexpr (std::is_rvalue_reference_v<Param>)
+				return std::move(arg);
+			else
+				return (arg);
+		}
+
+		// const arguments can only be bound to parameters taken by value or by const reference
+		template <typename... Params, std::size_t... indices>
+		bool CanBindArgs([[maybe_unused]] Span<AnyRef> args, std::index_sequence<indices...>)
+		{
+			return ((!IsMutableReference<Params>::value || !args[indices].IsConst()) && ...);
+		}
+
+		/*
+		* the object an argument is viewed through: arrays and functions decay to pointers (a string literal
+		* is passed as a const char*, not as a char[N]), other arguments are referenced
+		*/
+		template <typename T, typename U = std::remove_reference_t<T>>
+		using ArgView = std::conditional_t<std::is_array_v<U> || std::is_function_v<U>, std::decay_t<U>, U&>;
+
+		// the decayed pointers are held by views, which must outlive the returned references
+		template <typename... Views>
+		std::array<AnyRef, sizeof...(Views)> MakeArgRefs(std::tuple<Views...> &views)
+		{
+			return std::apply([](auto&... view) { return std::array<AnyRef, sizeof...(Views)>{ AnyRef(view)... }; }, views);
+		}
+
+	}  // namespace Details
+
+}  // namespace Reflect
+
+#endif  // CONVERSION_PLAN_H
@@ -4,28 +4,376 @@
 #include "TypeDescriptor.hpp"
 #include "Any.hpp"
 #include <string>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <tuple>
+#include <utility>
 
 namespace Reflect
 {
 
+	template <typename T>
+	class FieldAccessor;
+
+	namespace Details
+	{
+
+		/*
+		* byte offset of a data member from its member pointer: the member pointer is applied to a suitably aligned
+		* address (as for base offsets), only the address of the data member is computed, no object is accessed
+		*/
+		template <typename Class, typename Type>
+		std::size_t GetMemberOffset(Type Class::*dataMemberPtr)
+		{
+			const Class *object = reinterpret_cast<const Class*>(std::uintptr_t(0x1000) * alignof(Class));
+
+			return reinterpret_cast<const char*>(&(object->*dataMemberPtr)) - reinterpret_cast<const char*>(object);
+		}
+
+	}  // namespace Details
+
+	// result of the non throwing data member accessors
+	enum class AccessStatus
+	{
+		Success,
+		BadObject,  // the object can't be cast to the data member's class
+		BadValue,   // the value can't be cast or converted to the data member's type
+		ReadOnly    // the data member is const
+	};
+
 	class DataMember
 	{
 	public:
-		std::string GetName() const { return mName; }
+		const std::string &GetName() const { return mName; }
 		const TypeDescriptor *GetParent() const { return mParent; }
 		const TypeDescriptor *GetType() const { return mType; }
+		bool IsReadOnly() const { return mIsReadOnly; }
+
+		static constexpr std::size_t NO_OFFSET = static_cast<std::size_t>(-1);
+
+		/*
+		* byte offset of the data member in an object of objectType (the data member's class if nullptr, or a class derived from it
+		* through non virtual bases); NO_OFFSET if the data member isn't stored at a fixed offset (i.e. accessed through a setter and a getter).
+		* Together with GetType() it allows raw copies of the data member (memcpy of GetType()->GetSize() bytes for trivially copyable types)
+		*/
+		std::size_t GetOffset(const TypeDescriptor *objectType = nullptr) const;
+
+		/*
+		* typed accessor for hot loops: the type is checked once, here (T must be the data member's type, const qualified if the
+		* data member is const), the accessor then reads and writes the data member at native speed; the accessor is invalid
+		* if the type doesn't match or the data member has no fixed offset in objectType
+		*/
+		template <typename T>
+		FieldAccessor<T> Accessor(const TypeDescriptor *objectType = nullptr) const
+		{
+			if (std::is_reference_v<T> || Details::Resolve<Details::RawType<T>>() != mType || (mIsReadOnly && !std::is_const_v<T>))
+				return FieldAccessor<T>();
+
+			return FieldAccessor<T>(GetOffset(objectType));
+		}
+
+		// throw BadCastException if the object or the value can't be cast
+		void Set(AnyRef objectRef, const Any &value) const
+		{
+			ThrowIfFailed(TrySet(objectRef, value), objectRef, value);
+		}
+
+		// the value held by an rvalue Any is moved into the data member (or to a setter taking it by value or by rvalue reference)
+		void Set(AnyRef objectRef, Any &&value) const
+		{
+			ThrowIfFailed(TrySet(objectRef, std::move(value)), objectRef, value);
+		}
+
+		// returns a copy of the data member (use GetRef to avoid copying it)
+		Any Get(AnyRef objectRef) const
+		{
+			Any value;
+
+			if (TryGet(objectRef, value) != AccessStatus::Success)
+				throw BadCastException(mParent, objectRef.GetType());
+
+			return value;
+		}
+
+		/*
+		* non owning view of the data member in place (no copies nor allocations), empty if the object can't be cast, if the data member
+		* is read only (use GetConstRef) or if it isn't stored in the object (a getter that doesn't return a reference)
+		*/
+		AnyRef GetRef(AnyRef objectRef) const
+		{
+			return GetRefImpl(objectRef, true);
+		}
+
+		// const view of the data member (it can be taken from a const object)
+		AnyRef GetConstRef(AnyRef objectRef) const
+		{
+			return GetRefImpl(objectRef, false);
+		}
+
+		/*
+		* copies the data member of each object into a column of (constructed) objects of the data member's type, elements
+		* stride bytes apart (packed if stride is 0); Scatter copies them back. The cast of the objects and the data member's offset
+		* are resolved once for the whole batch (once per object for a Span of AnyRef), objects that can't be cast are skipped;
+		* return the number of objects copied from (to)
+		*/
+		template <typename T>
+		std::size_t Gather(Span<T> objects, void *column, std::size_t stride = 0) const
+		{
+			return GatherWith(Details::MakeBatchColumn(objects), false, objects.size(), column, stride);
+		}
+
+		template <typename T>
+		std::size_t Scatter(Span<T> objects, const void *column, std::size_t stride = 0) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, objects.size(), column, stride ? stride : mType->GetSize(), false);
+		}
+
+		// sets the data member of each object to value (an object of the data member's type)
+		template <typename T>
+		std::size_t Fill(Span<T> objects, const void *value) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, objects.size(), value, 0, false);
+		}
+
+		// sets the data member of the i-th object to *values[i] (an object of the data member's type)
+		template <typename T>
+		std::size_t ScatterIndirect(Span<T> objects, Span<const void* const> values) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, std::min(objects.size(), values.size()), values.data(), sizeof(void*), true);
+		}
+
+		// objects are (non null) pointers to objects of objectType
+		std::size_t Gather(Span<void* const> objects, const TypeDescriptor *objectType, void *column, std::size_t stride = 0) const
+		{
+			return GatherWith({ objects.data(), sizeof(void*), objectType, false }, true, objects.size(), column, stride);
+		}
+
+		std::size_t Scatter(Span<void* const> objects, const TypeDescriptor *objectType, const void *column, std::size_t stride = 0) const
+		{
+			return ScatterWith({ objects.data(), sizeof(void*), objectType, false }, true, objects.size(), column, stride ? stride : mType->GetSize(), false);
+		}
+
+		// don't throw nor allocate on failure (mismatches can be probed cheaply)
+		AccessStatus TrySet(AnyRef objectRef, const Any &value) const
+		{
+			return TrySetWith(objectRef, value, false);
+		}
+
+		AccessStatus TrySet(AnyRef objectRef, Any &&value) const
+		{
+			return TrySetWith(objectRef, value, !value.IsRef());  // an AnyRef's object isn't owned by the Any, it's copied
+		}
+
+		AccessStatus TryGet(AnyRef objectRef, Any &value) const  // value's object is reused if it's of the data member's type
+		{
+			REFLECT_CALL_SCOPE(scope);
 
-		virtual void Set(AnyRef objectRef, const Any value) = 0;
-		virtual Any Get(Any object) = 0;
+			AccessStatus status = TryGetImpl(objectRef, value);
+			REFLECT_CALL_RESULT(scope, status == AccessStatus::Success);
+
+			return status;
+		}
 
 	protected:
-		DataMember(const std::string &name, const TypeDescriptor *type, const TypeDescriptor *parent)
-			: mName(name), mType(type), mParent(parent) {}
+		DataMember(const std::string &name, const TypeDescriptor *type, const TypeDescriptor *parent, std::size_t offset = NO_OFFSET, bool isReadOnly = false)
+			: mName(name), mType(type), mParent(parent), mOffset(offset), mIsReadOnly(isReadOnly) {}
+
+		/*
+		* calls visit(i, Class*) for each object of a column of objects (or of pointers to objects if isIndirect), objects at a fixed
+		* offset from Class (the common case) are visited by a plain strided loop; returns the number of objects visited
+		*/
+		template <typename Class, typename F>
+		static std::size_t ForEachObject(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, F &&visit)
+		{
+			const TypeDescriptor *classType = Details::Resolve<Class>();
+			const char *data = static_cast<const char*>(objects.Data);
+
+			auto getObject = [data, &objects, isIndirect](std::size_t index) -> char*
+			{
+				const char *element = data + index * objects.Stride;
+
+				return isIndirect ? *reinterpret_cast<char* const*>(element) : const_cast<char*>(element);
+			};
+
+			if (!objects.Type)  // AnyRef column: each object has its own type
+			{
+				std::size_t visited = 0;
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const AnyRef &objectRef = *reinterpret_cast<const AnyRef*>(data + i * objects.Stride);
+
+					if (Class *object = objectRef.TryCast<Class>())  // const views are skipped unless Class is const
+					{
+						visit(i, object);
+						++visited;
+					}
+				}
+
+				return visited;
+			}
+
+			if (objects.IsConst && !std::is_const_v<Class>)  // the objects can't be modified
+				return 0;
+
+			std::ptrdiff_t offset = 0;
+
+			if (objects.Type != classType)
+			{
+				const Details::BaseCast *baseCast = objects.Type->FindBaseCast(classType);
+
+				if (!baseCast)
+					return 0;
+
+				if (baseCast->Step)  // derived through a virtual base: cast each object
+				{
+					for (std::size_t i = 0; i < count; ++i)
+						visit(i, static_cast<Class*>(objects.Type->Cast(getObject(i), classType)));
+
+					return count;
+				}
+
+				offset = baseCast->Offset;
+			}
+
+			if (isIndirect)
+				for (std::size_t i = 0; i < count; ++i)
+					visit(i, reinterpret_cast<Class*>(*reinterpret_cast<char* const*>(data + i * objects.Stride) + offset));
+			else
+				for (std::size_t i = 0; i < count; ++i)
+					visit(i, reinterpret_cast<Class*>(const_cast<char*>(data) + i * objects.Stride + offset));
+
+			return count;
+		}
+
+		// the index-th value of a column scattered to the objects (see ScatterWith)
+		template <typename T>
+		static const T &ColumnValue(const char *column, std::size_t stride, bool isIndirectColumn, std::size_t index)
+		{
+			const char *element = column + index * stride;
+
+			return isIndirectColumn ? **reinterpret_cast<const T* const*>(element) : *reinterpret_cast<const T*>(element);
+		}
 
 	private:
+		AccessStatus TrySetWith(AnyRef objectRef, const Any &value, bool isMovable) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			AccessStatus status = TrySetImpl(objectRef, value, isMovable);
+			REFLECT_CALL_RESULT(scope, status == AccessStatus::Success);
+
+			return status;
+		}
+
+		std::size_t GatherWith(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, void *column, std::size_t stride) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t copied = GatherImpl(objects, isIndirect, count, static_cast<char*>(column), stride ? stride : mType->GetSize());
+			REFLECT_BATCH_RESULT(scope, count, copied);
+
+			return copied;
+		}
+
+		// a stride of 0 copies the same value to every object, the elements of an indirect column are pointers to the values
+		std::size_t ScatterWith(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const void *column, std::size_t stride, bool isIndirectColumn) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t copied = ScatterImpl(objects, isIndirect, count, static_cast<const char*>(column), stride, isIndirectColumn);
+			REFLECT_BATCH_RESULT(scope, count, copied);
+
+			return copied;
+		}
+
+		void ThrowIfFailed(AccessStatus status, AnyRef objectRef, const Any &value) const
+		{
+			if (status == AccessStatus::BadObject)
+				throw BadCastException(mParent, objectRef.GetType(), "object:");
+
+			if (status == AccessStatus::BadValue)
+				throw BadCastException(mType, value.GetType(), "value:");
+		}
+
+		// the value's object can be moved from if isMovable is true (converted temporaries are always moved from)
+		virtual AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const = 0;
+		virtual AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const = 0;
+		virtual AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const = 0;
+		virtual std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const = 0;
+		virtual std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const = 0;
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const DataMember *dataMember = static_cast<const DataMember*>(metaObject);
+
+			stats.TypeName = dataMember->mParent->GetName();
+			stats.Kind = "data member";
+			stats.Description = dataMember->mName;
+		}
+#endif
+
 		std::string mName;                 
 		const TypeDescriptor *mType;    // type of the data member
 		const TypeDescriptor *mParent;  // type of the data member's class
+		std::size_t mOffset;            // offset in an object of the data member's class (NO_OFFSET if not stored at a fixed offset)
+		bool mIsReadOnly;
+
+		REFLECT_STATS_ID(&DataMember::Describe)
+	};
+
+	inline std::size_t DataMember::GetOffset(const TypeDescriptor *objectType) const
+	{
+		if (mOffset == NO_OFFSET || !objectType || objectType == mParent)
+			return mOffset;
+
+		const Details::BaseCast *baseCast = objectType->FindBaseCast(mParent);
+
+		if (!baseCast || baseCast->Step)  // not derived from the data member's class or derived through a virtual base
+			return NO_OFFSET;
+
+		return mOffset + baseCast->Offset;
+	}
+
+	/*
+	* reads and writes a data member of type T (const T for read only data members) at a fixed offset,
+	* object must point to an object of the type the accessor was created for
+	*/
+	template <typename T>
+	class FieldAccessor
+	{
+	public:
+		FieldAccessor() : mOffset(DataMember::NO_OFFSET) {}  // invalid accessor
+
+		bool IsValid() const { return mOffset != DataMember::NO_OFFSET; }
+		explicit operator bool() const { return IsValid(); }
+
+		std::size_t GetOffset() const { return mOffset; }
+
+		T &Get(void *object) const
+		{
+			return *reinterpret_cast<T*>(static_cast<char*>(object) + mOffset);
+		}
+
+		const T &Get(const void *object) const
+		{
+			return *reinterpret_cast<const T*>(static_cast<const char*>(object) + mOffset);
+		}
+
+		template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+		void Set(void *object, const T &value) const
+		{
+			Get(object) = value;
+		}
+
+	private:
+		friend class DataMember;
+
+		explicit FieldAccessor(std::size_t offset) : mOffset(offset) {}
+
+		std::size_t mOffset;
 	};
 
 	template <typename Class, typename Type>
@@ -33,26 +381,64 @@ namespace Reflect
 	{
 	public:
 		PtrDataMember(Type Class::*dataMemberPtr, const std::string name)
-			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>()), mDataMemberPtr(dataMemberPtr) {}
+			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>(), Details::GetMemberOffset(dataMemberPtr), std::is_const_v<Type>), mDataMemberPtr(dataMemberPtr) {}
 
-		// void Set(AnyRef objectRef, const Any value) override
+		// AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
 		// {
-		// 	SetImpl(objectRef, value);  // use SFINAE
+		// 	return SetImpl(objectRef, value, isMovable);  // use SFINAE
 		// }
 
-		void Set(AnyRef objectRef, const Any value) override
+		AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
 		{
-			SetImpl(objectRef, value, std::is_const<Type>());  // use tag dispatch
+			return SetImpl(objectRef, value, isMovable, std::is_const<Type>());  // use tag dispatch
 		}
 
-		Any Get(Any object) override
+		AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const override
 		{
-			Class *obj = object.TryCast<Class>();
+			const Class *obj = objectRef.TryCast<const Class>();
 
 			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName());
+				return AccessStatus::BadObject;
+
+			Details::StoreResult<Details::RawType<Type>>({ &value, nullptr }, [&]() -> Details::RawType<Type> { return obj->*mDataMemberPtr; });
+
+			return AccessStatus::Success;
+		}
+
+		AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const override
+		{
+			if (!isMutable)
+			{
+				const Class *obj = objectRef.TryCast<const Class>();
+
+				return obj ? AnyRef(obj->*mDataMemberPtr) : AnyRef();
+			}
+
+			Class *obj = objectRef.TryCast<Class>();
+
+			if (!obj || std::is_const_v<Type>)
+				return AnyRef();
+
+			return AnyRef(obj->*mDataMemberPtr);
+		}
+
+		std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const override
+		{
+			return ForEachObject<const Class>(objects, isIndirect, count, [this, column, stride](std::size_t index, const Class *obj)
+			{
+				*reinterpret_cast<Details::RawType<Type>*>(column + index * stride) = obj->*mDataMemberPtr;
+			});
+		}
 
-			return obj->*mDataMemberPtr;
+		std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const override
+		{
+			if constexpr (std::is_const_v<Type>)
+				return 0;
+			else
+				return ForEachObject<Class>(objects, isIndirect, count, [this, column, stride, isIndirectColumn](std::size_t index, Class *obj)
+				{
+					obj->*mDataMemberPtr = ColumnValue<Type>(column, stride, isIndirectColumn, index);
+				});
 		}
 
 	private:
@@ -80,30 +466,31 @@ namespace Reflect
 		// }
 
 		////// use tag dispatch
-		void SetImpl(Any object, const Any value, std::false_type)
+		AccessStatus SetImpl(AnyRef objectRef, const Any &value, bool isMovable, std::false_type) const
 		{
-			Class *obj = object.TryCast<Class>();  // pointers to members of base class can be used with derived class
+			Class *obj = objectRef.TryCast<Class>();  // pointers to members of base class can be used with derived class
 
 			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName(), "object:");
+				return AccessStatus::BadObject;
 
-			Type const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<Type>(); !casted)
-			{
-				val = value.TryConvert<Type>();
-				casted = val.TryCast<Type>();
-			}
+			Any converted;
+			Type *casted = Details::CastOrConvert<Type>(value, converted);  // converted only if the value isn't a Type
 
 			if (!casted)
-				throw BadCastException(Details::Resolve<Type>()->GetName(), value.GetType()->GetName(), "value:");
+				return AccessStatus::BadValue;
+
+			if (isMovable || converted)
+				obj->*mDataMemberPtr = std::move(*casted);
+			else
+				obj->*mDataMemberPtr = *casted;
 
-			obj->*mDataMemberPtr = *casted;
+			return AccessStatus::Success;
 		}
 
-		void SetImpl(Any object, const Any value, std::true_type)
+		AccessStatus SetImpl(AnyRef, const Any&, bool, std::true_type) const
 		{
 			//static_assert(false, "can't set const data member");
+			return AccessStatus::ReadOnly;
 		}
 	};
 
@@ -132,49 +519,92 @@ namespace Reflect
 	{
 	private:
 		using MemberType = Details::RawType<typename decltype(ToFunctionHelper(Getter))::ReturnType>;
+		using SetterParams = typename decltype(ToFunctionHelper(Setter))::ParamsTypes;
+		using SetterParamType = std::tuple_element_t<std::tuple_size_v<SetterParams> - 1, SetterParams>;  // the value is the last parameter
+		using GetterClass = std::conditional_t<std::is_invocable_v<decltype(Getter), const Class&>, const Class, Class>;  // a const getter reads const objects
 
 	public:
 		SetGetDataMember(const std::string name)
 			: DataMember(name, Details::Resolve<MemberType>(), Details::Resolve<Class>()) {}
 
-		void Set(AnyRef objectRef, const Any value) override
+		AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
 		{
-			Any a = objectRef;
-			Class *obj = a.TryCast<Class>();
+			Class *obj = objectRef.TryCast<Class>();
 
 			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), Any(objectRef).GetType()->GetName(), "object:");
+				return AccessStatus::BadObject;
 
-			MemberType const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<MemberType>(); !casted)
-			{
-				val = value.TryConvert<MemberType>();
-				casted = val.TryCast<MemberType>();
-			}
+			Any converted;
+			MemberType *casted = Details::CastOrConvert<MemberType>(value, converted);  // converted only if the value isn't a MemberType
 
 			if (!casted)
-				throw BadCastException(Details::Resolve<MemberType>()->GetName(), value.GetType()->GetName(), "value:");
+				return AccessStatus::BadValue;
 
-			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
-				(obj->*Setter)(*casted);
+			if (isMovable || converted)
+				CallSetter(obj, std::move(*casted));
 			else
+				CopyToSetter(obj, *casted);
+
+			return AccessStatus::Success;
+		}
+
+		AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const override
+		{
+			GetterClass *obj = objectRef.TryCast<GetterClass>();
+
+			if (!obj)
+				return AccessStatus::BadObject;
+
+			Details::StoreResult<MemberType>({ &value, nullptr }, [obj]() -> MemberType { return CallGetter(obj); });
+
+			return AccessStatus::Success;
+		}
+
+		// only getters returning a reference give access to the data member in place
+		AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const override
+		{
+			using GetterReturnType = typename decltype(ToFunctionHelper(Getter))::ReturnType;
+
+			if constexpr (std::is_lvalue_reference_v<GetterReturnType>)
 			{
-				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Setter)>>);
+				if (!isMutable)
+				{
+					GetterClass *obj = objectRef.TryCast<GetterClass>();
 
-				Setter(*obj, *casted);
-			}
+					return obj ? AnyRef(std::as_const(CallGetter(obj))) : AnyRef();
+				}
+
+				Class *obj = objectRef.TryCast<Class>();
 
+				if (!obj || std::is_const_v<std::remove_reference_t<GetterReturnType>>)
+					return AnyRef();
+
+				return AnyRef(CallGetter(obj));
+			}
+			else
+				return AnyRef();
 		}
 
-		Any Get(Any object) override
+		std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const override
 		{
-			Class *obj = object.TryCast<Class>();
+			return ForEachObject<GetterClass>(objects, isIndirect, count, [column, stride](std::size_t index, GetterClass *obj)
+			{
+				*reinterpret_cast<MemberType*>(column + index * stride) = CallGetter(obj);
+			});
+		}
 
-			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName());
+		std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const override
+		{
+			return ForEachObject<Class>(objects, isIndirect, count, [column, stride, isIndirectColumn](std::size_t index, Class *obj)
+			{
+				CopyToSetter(obj, ColumnValue<MemberType>(column, stride, isIndirectColumn, index));
+			});
+		}
 
-			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
+	private:
+		static decltype(auto) CallGetter(GetterClass *obj)
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Getter)>)
 				return (obj->*Getter)();
 			else
 			{
@@ -183,6 +613,27 @@ namespace Reflect
 				return Getter(*obj);
 			}
 		}
+
+		template <typename T>
+		static void CallSetter(Class *obj, T &&value)
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
+				(obj->*Setter)(std::forward<T>(value));
+			else
+			{
+				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Setter)>>);
+
+				Setter(*obj, std::forward<T>(value));
+			}
+		}
+
+		static void CopyToSetter(Class *obj, const MemberType &value)
+		{
+			if constexpr (std::is_rvalue_reference_v<SetterParamType>)
+				CallSetter(obj, MemberType(value));  // the setter only takes rvalues: pass it a copy
+			else
+				CallSetter(obj, value);
+		}
 	};
 
 }  // namespace Reflect
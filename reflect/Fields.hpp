@@ -0,0 +1,77 @@
+#ifndef FIELDS_H
+#define FIELDS_H
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Reflect
+{
+
+	// a data member known at compile time
+	template <typename Class, typename Type>
+	struct Field
+	{
+		using ClassType = Class;
+		using MemberType = Type;
+
+		const char *Name;
+		Type Class::*Ptr;
+	};
+
+	template <typename Class, typename Type>
+	constexpr Field<Class, Type> MakeField(const char *name, Type Class::*ptr)
+	{
+		return { name, ptr };
+	}
+
+	template <typename... Fields>
+	constexpr std::tuple<Fields...> MakeFields(Fields... fields)
+	{
+		return { fields... };
+	}
+
+	/*
+	* compile time list of the data members of a type, declared once by specializing FieldList:
+	*
+	*	template <>
+	*	struct Reflect::FieldList<Vec3>
+	*	{
+	*		static constexpr auto Fields = Reflect::MakeFields(Reflect::MakeField("x", &Vec3::x), Reflect::MakeField("y", &Vec3::y));
+	*	};
+	*
+	* ForEachField visits the fields of an object with straight-line code (no meta objects involved),
+	* TypeFactory::AddFields registers the same fields as data members of the type descriptor
+	*/
+	template <typename Type>
+	struct FieldList;
+
+	template <typename Type, typename = void>
+	struct HasFieldList : std::false_type {};
+
+	template <typename Type>
+	struct HasFieldList<Type, std::void_t<decltype(FieldList<Type>::Fields)>> : std::true_type {};
+
+	template <typename Type>
+	constexpr std::size_t GetFieldCount()
+	{
+		static_assert(HasFieldList<Type>::value, "the type has no compile time field list");
+
+		return std::tuple_size_v<std::remove_const_t<decltype(FieldList<Type>::Fields)>>;
+	}
+
+	// calls visitor(name, field) for each field of object, in declaration order (fields of a const object are const)
+	template <typename Type, typename Visitor>
+	constexpr void ForEachField(Type &object, Visitor &&visitor)
+	{
+		using Class = std::remove_const_t<Type>;
+
+		static_assert(HasFieldList<Class>::value, "the type has no compile time field list");
+
+		std::apply([&object, &visitor](const auto&... fields) { (visitor(fields.Name, object.*(fields.Ptr)), ...); }, FieldList<Class>::Fields);
+	}
+
+}  // namespace Reflect
+
+#endif  // FIELDS_H
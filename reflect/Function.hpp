@@ -4,29 +4,328 @@
 #include <string>
 #include <vector>
 #include <tuple>
+#include <array>
 #include "TypeDescriptor.hpp"
 #include "Any.hpp"
+#include "Span.hpp"
+#include "Conversion.hpp"
+#include "ConversionPlan.hpp"
 
 namespace Reflect
 {
 
+	class Function;
+
+	namespace Details
+	{
+
+		/*
+		* BatchArg reads the elements of a column as T, the cast or conversion to T
+		* is resolved once per batch (once per call only for columns of AnyRef);
+		* the elements of a const column can only be read as a const T. Objects
+		* (IS_OBJECT) are only cast, never converted: a call on a converted
+		* temporary would lose its side effects
+		*/
+		template <typename T, bool IS_OBJECT = false>
+		class BatchArg
+		{
+		public:
+			bool Resolve(const BatchColumn &column)
+			{
+				mColumn = &column;
+
+				if (column.IsConst && !std::is_const_v<T>)
+					return false;
+
+				if (!column.Type)
+					mMode = Mode::Dynamic;
+				else if (column.Type == Details::Resolve<T>())
+					mMode = Mode::Direct;
+				else if (const BaseCast *baseCast = column.Type->FindBaseCast(Details::Resolve<T>()))
+				{
+					mMode = baseCast->Step ? Mode::Cast : Mode::Offset;  // only bases reached through a virtual base are cast per element
+					mOffset = baseCast->Offset;
+				}
+				else if constexpr (IS_OBJECT)
+					return false;
+				else
+				{
+					for (auto *conversion : column.Type->GetConversions())
+						if (conversion->GetToType() == Details::Resolve<T>())
+							mConversion = conversion;
+
+					if (!mConversion)
+						return false;
+
+					mMode = Mode::Convert;
+				}
+
+				if (column.Stride == 0)  // shared argument: cast or convert it once
+				{
+					mShared = Read(0);
+					mMode = Mode::Shared;
+
+					return mShared != nullptr;
+				}
+
+				return true;
+			}
+
+			T *Get(std::size_t index)
+			{
+				return mMode == Mode::Shared ? mShared : Read(index);
+			}
+
+		private:
+			enum class Mode { Direct, Offset, Cast, Convert, Dynamic, Shared };
+
+			T *Read(std::size_t index)
+			{
+				void *element = const_cast<void*>(static_cast<const void*>(static_cast<const char*>(mColumn->Data) + index * mColumn->Stride));
+
+				switch (mMode)
+				{
+				case Mode::Direct:
+					return static_cast<T*>(element);
+				case Mode::Offset:
+					return reinterpret_cast<T*>(static_cast<char*>(element) + mOffset);
+				case Mode::Cast:
+					return static_cast<T*>(mColumn->Type->Cast(element, Details::Resolve<T>()));
+				case Mode::Convert:
+					mConverted = mConversion->Convert(element);
+					return mConverted.TryCast<T>();
+				case Mode::Dynamic:
+				{
+					const AnyRef &ref = *static_cast<AnyRef*>(element);
+
+					if constexpr (IS_OBJECT)
+						return ref.TryCast<T>();
+					else
+						return std::is_const_v<T> || !ref.IsConst() ? CastOrConvert<T>(ref, mConverted) : nullptr;
+				}
+				default:
+					return mShared;
+				}
+			}
+
+			const BatchColumn *mColumn = nullptr;
+			Mode mMode = Mode::Direct;
+			std::ptrdiff_t mOffset = 0;
+			const Conversion *mConversion = nullptr;
+			Any mConverted;
+			T *mShared = nullptr;
+		};
+
+		// how a batch reads an argument for a parameter: only arguments bound to a non const reference can be modified
+		template <typename Param>
+		using BatchArgType = std::conditional_t<IsMutableReference<Param>::value, RawType<Param>, const RawType<Param>>;
+
+		// T&& parameters of a batch receive a copy of the argument: a shared argument is passed to every call
+		template <typename Param, typename T>
+		decltype(auto) PassBatchArg(T &arg)
+		{
+			if constexpr (std::is_rvalue_reference_v<Param>)
+				return RawType<Param>(arg);
+			else
+				return (arg);
+		}
+
+		/*
+		* calls a function (through its thunk) once for each element of the object column and stores the returned values in results (if not empty),
+		* C is void for free functions (const for const member functions), returns the number of calls made (calls whose object or arguments
+		* can't be cast or converted are skipped)
+		*/
+		template <typename C, typename Ret, typename... Args, typename Thunk, std::size_t... indices>
+		std::size_t InvokeBatch(Thunk thunk, const Function *function, const BatchColumn &objects, [[maybe_unused]] Span<const BatchColumn> args, std::size_t count, Span<Any> results, std::index_sequence<indices...>)
+		{
+			[[maybe_unused]] std::conditional_t<std::is_void_v<C>, int, BatchArg<C, true>> object{};
+			[[maybe_unused]] std::tuple<BatchArg<BatchArgType<Args>>...> batchArgs;
+
+			if constexpr (!std::is_void_v<C>)
+				if (!object.Resolve(objects))
+					return 0;
+
+			if (!(std::get<indices>(batchArgs).Resolve(args[indices]) && ...))
+				return 0;
+
+			std::size_t calls = 0;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				[[maybe_unused]] std::tuple<BatchArgType<Args>*...> argsTuple{ std::get<indices>(batchArgs).Get(i)... };
+				[[maybe_unused]] C *obj = nullptr;
+
+				bool isValid = (std::get<indices>(argsTuple) && ...);
+
+				if constexpr (!std::is_void_v<C>)
+					isValid = isValid && (obj = object.Get(i));
+
+				if (!isValid)
+				{
+					if (!results.empty())
+						results[i].Reset();
+
+					continue;
+				}
+
+				auto call = [&]() -> Ret
+				{
+					if constexpr (std::is_void_v<C>)
+						return thunk(function, PassBatchArg<Args>(*std::get<indices>(argsTuple))...);
+					else
+						return thunk(function, *obj, PassBatchArg<Args>(*std::get<indices>(argsTuple))...);
+				};
+
+				StoreResult<Ret>({ results.empty() ? nullptr : &results[i], nullptr }, call);
+
+				++calls;
+			}
+
+			return calls;
+		}
+
+	}  // namespace Details
+
+	/*
+	* Invoker is a typed handle to a reflected function, it calls the function directly
+	* with native arguments (no Any, no casts or conversions and no virtual calls)
+	*/
+	template <typename Signature>
+	class Invoker;
+
+	template <typename Ret, typename... Args>
+	class Invoker<Ret(Args...)>
+	{
+		friend class Function;
+
+	public:
+		Invoker() : mFunction(nullptr), mThunk(nullptr) {}
+
+		explicit operator bool() const { return mThunk != nullptr; }
+
+		Ret operator()(Args... args) const
+		{
+			return mThunk(mFunction, std::forward<Args>(args)...);
+		}
+
+	private:
+		using Thunk = Ret(*)(const Function*, Args...);
+
+		Invoker(const Function *function, Thunk thunk) : mFunction(function), mThunk(thunk) {}
+
+		const Function *mFunction;
+		Thunk mThunk;
+	};
+
 	class Function
 	{
 	public:
-		std::string GetName() const { return mName; }
+		const std::string &GetName() const { return mName; }
 		const TypeDescriptor *GetParent() const { return mParent; }
 
 		template <typename... Args>
 		Any Invoke(AnyRef object, Args&&... args) const
 		{
-			if (sizeof...(Args) == mParamTypes.size())
-			{
-				std::vector<Any> anyArgs{ Any(std::forward<Args>(args))... };
+			Any result;
+			InvokeInto(object, result, args...);
 
-				return InvokeImpl(object, anyArgs);
-			}
+			return result;
+		}
+
+		/*
+		* invokes the function and stores the returned value in result, the object already held by result is assigned
+		* (reusing its storage) if it's of the return type; returns false (and resets result) if the call can't be made
+		*/
+		template <typename... Args>
+		bool InvokeInto(AnyRef object, Any &result, Args&&... args) const
+		{
+			if (InvokeWith(object, { &result, nullptr }, args...))
+				return true;
+
+			result.Reset();
+
+			return false;
+		}
+
+		/*
+		* invoke with arguments only known at run time (i.e. the stack slots of a script VM), the arguments
+		* are passed to the function without being copied (pass a Span, other containers are taken as a single argument)
+		*/
+		Any Invoke(AnyRef object, Span<AnyRef> args) const
+		{
+			Any result;
+			InvokeInto(object, result, args);
 
-			return Any();
+			return result;
+		}
+
+		bool InvokeInto(AnyRef object, Any &result, Span<AnyRef> args) const
+		{
+			if (args.size() == mParamTypes.size() && Dispatch(object, args, { &result, nullptr }))
+				return true;
+
+			result.Reset();
+
+			return false;
+		}
+
+		/*
+		* invokes the function and constructs the returned value in storage (uninitialized memory with the size and alignment of the return type),
+		* type must be the return type (a referenced object is copied); the caller owns the constructed object
+		*/
+		template <typename... Args>
+		bool InvokeInto(AnyRef object, void *storage, const TypeDescriptor *type, Args&&... args) const
+		{
+			return type == mReturnType && InvokeWith(object, { nullptr, storage }, args...);
+		}
+
+		/*
+		* returns an invoker if Signature is the exact signature of the function, an empty invoker otherwise:
+		* Ret(Args...) for free functions, Ret(C&, Args...) for member functions and Ret(const C&, Args...) for const member functions
+		*/
+		template <typename Signature>
+		Invoker<Signature> Bind() const
+		{
+			if (Details::GetTypeId<Signature>() == mSignature)  // the signature is checked once, when binding
+				return Invoker<Signature>(this, reinterpret_cast<typename Invoker<Signature>::Thunk>(mThunk));
+
+			return Invoker<Signature>();
+		}
+
+		/*
+		* invokes the function once for each object with the same arguments, casts and conversions are resolved once for the whole batch;
+		* results (if not empty, it must have at least as many elements as objects) receive the returned values,
+		* returns the number of calls made
+		*/
+		template <typename T, typename... Args>
+		std::size_t InvokeBatch(Span<T> objects, Span<Any> results, Args&&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size() || (!results.empty() && results.size() < objects.size()))
+				return 0;
+
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);
+			std::array<Details::BatchColumn, sizeof...(Args)> columns;
+
+			for (std::size_t i = 0; i < argRefs.size(); ++i)
+				columns[i] = { &argRefs[i], 0, nullptr, false };  // shared arguments (each AnyRef keeps its constness)
+
+			return DispatchBatch(Details::MakeBatchColumn(objects), columns, objects.size(), results);
+		}
+
+		/*
+		* invokes the function once for each object, the i-th call takes its arguments from the i-th element of each column
+		* (each column must have at least as many elements as objects)
+		*/
+		template <typename T, typename... Columns>
+		std::size_t InvokeBatchColumns(Span<T> objects, Span<Any> results, Span<Columns>... columns) const
+		{
+			if (sizeof...(Columns) != mParamTypes.size() || (!results.empty() && results.size() < objects.size()) || ((columns.size() < objects.size()) || ...))
+				return 0;
+
+			std::array<Details::BatchColumn, sizeof...(Columns)> argColumns{ Details::MakeBatchColumn(columns)... };
+
+			return DispatchBatch(Details::MakeBatchColumn(objects), argColumns, objects.size(), results);
 		}
 
 		const TypeDescriptor *GetReturnType() const
@@ -50,17 +349,76 @@ namespace Reflect
 		}
 
 	protected:
-		Function(const std::string &name, const TypeDescriptor *parent, const TypeDescriptor *returnType, const std::vector<TypeDescriptor const*> paramTypes)
-			: mName(name), mParent(parent), mReturnType(returnType), mParamTypes(paramTypes) {}
+		using Thunk = void(*)();  // type erased function that calls the stored function pointer (cast back to the exact type by Bind)
+
+		Function(const std::string &name, const TypeDescriptor *parent, const TypeDescriptor *returnType, const std::vector<TypeDescriptor const*> paramTypes, TypeId signature, Thunk thunk)
+			: mName(name), mParent(parent), mReturnType(returnType), mParamTypes(paramTypes), mSignature(signature), mThunk(thunk) {}
 
 		const TypeDescriptor *mReturnType;
 		std::vector<TypeDescriptor const *> mParamTypes;
 
+		template <typename... Args>
+		bool InvokeWith(AnyRef object, const Details::ResultStorage &result, Args&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size())
+				return false;
+
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);  // arguments are referenced, not copied (no heap allocations)
+
+			return Dispatch(object, argRefs, result);
+		}
+
+		const Details::ConversionPlan *FindConversionPlan(Span<AnyRef> args) const
+		{
+			return mConversionPlans.Find(args, mParamTypes);
+		}
+
 	private:
-		virtual Any InvokeImpl(Any object, std::vector<Any> &args) const = 0;
+		virtual bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const = 0;
+		virtual std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const = 0;
+
+		// all the calls (except the ones made through a bound invoker) go through here
+		bool Dispatch(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			bool isSuccess = InvokeImpl(object, args, result);
+			REFLECT_CALL_RESULT(scope, isSuccess);
+
+			return isSuccess;
+		}
+
+		std::size_t DispatchBatch(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t calls = InvokeBatchImpl(objects, args, count, results);
+			REFLECT_BATCH_RESULT(scope, count, calls);
+
+			return calls;
+		}
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const Function *function = static_cast<const Function*>(metaObject);
+
+			stats.TypeName = function->mParent ? function->mParent->GetName() : "";
+			stats.Kind = "function";
+			stats.Description = function->mName;
+		}
+#endif
 
 		std::string mName;
 		TypeDescriptor const *const mParent;
+
+		TypeId mSignature;
+		Thunk mThunk;
+
+		mutable Details::ConversionPlanCache mConversionPlans;
+
+		REFLECT_STATS_ID(&Function::Describe)
 	};
 
 
@@ -72,28 +430,42 @@ namespace Reflect
 
 	public:
 		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mFreeFunPtr(freeFunPtr) {}
+			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(Args...)>(), reinterpret_cast<Thunk>(&FreeFunction::Call)), mFreeFunPtr(freeFunPtr) {}
 
 	private:
-		Any InvokeImpl(Any, std::vector<Any> &args) const override
+		static Ret Call(const Function *function, Args... args)
+		{
+			return static_cast<const FreeFunction*>(function)->mFreeFunPtr(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<void, Ret, Args...>(&FreeFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef, Span<AnyRef> args, const Details::ResultStorage &result) const override
 		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
+			return InvokeImpl(args, result, std::index_sequence_for<Args...>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			if ((std::get<indices>(argsTuple) && ...))  // all arguments are valid
-				if constexpr (std::is_reference_v<Ret>)
-					return AnyRef(mFreeFunPtr(*std::get<indices>(argsTuple)...));
-				else
-					return mFreeFunPtr(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
+
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
+
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
+
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return mFreeFunPtr(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
 		FunPtr mFreeFunPtr;
@@ -108,26 +480,42 @@ namespace Reflect
 
 	public:
 		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mFreeFunPtr(freeFunPtr) {}
+			: Function(name, nullptr, Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<void(Args...)>(), reinterpret_cast<Thunk>(&FreeFunction::Call)), mFreeFunPtr(freeFunPtr) {}
 
 	private:
-		Any InvokeImpl(Any, std::vector<Any> &args) const override
+		static void Call(const Function *function, Args... args)
 		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
+			static_cast<const FreeFunction*>(function)->mFreeFunPtr(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<void, void, Args...>(&FreeFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(args, result, std::index_sequence_for<Args...>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
+
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			if ((std::get<indices>(argsTuple) && ...))  // all arguments are valid
-				mFreeFunPtr(*std::get<indices>(argsTuple)...);
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
 
-			return Any();
+			Details::StoreResult<void>(result, [&]() -> void { return mFreeFunPtr(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
 		FunPtr mFreeFunPtr;
@@ -142,28 +530,44 @@ namespace Reflect
 
 	public:
 		MemberFunction(MemFunPtr memFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mMemFunPtr(memFun) {}
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(C&, Args...)>(), reinterpret_cast<Thunk>(&MemberFunction::Call)), mMemFunPtr(memFun) {}
 
 	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
+		static Ret Call(const Function *function, C &object, Args... args)
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
+			return (object.*static_cast<const MemberFunction*>(function)->mMemFunPtr)(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<C, Ret, Args...>(&MemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			if (C *obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // object is valid and all arguments are valid 
-				if constexpr (std::is_reference_v<Ret>)
-					return AnyRef((obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...));
-				else
-					return (obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
+
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
+
+			C *obj = object.TryCast<C>();  // a const object can't be bound to a non const member function
+
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
+
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return (obj->*mMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
 		MemFunPtr mMemFunPtr;
@@ -178,26 +582,44 @@ namespace Reflect
 
 	public:
 		MemberFunction(MemFunPtr memFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mMemFunPtr(memFun) {}
+			: Function(name, Details::Resolve<C>(), Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<void(C&, Args...)>(), reinterpret_cast<Thunk>(&MemberFunction::Call)), mMemFunPtr(memFun) {}
 
 	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
+		static void Call(const Function *function, C &object, Args... args)
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
+			(object.*static_cast<const MemberFunction*>(function)->mMemFunPtr)(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<C, void, Args...>(&MemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-			if (C *obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // object is valid and all arguments are valid 
-				(obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			return Any();
+			C *obj = object.TryCast<C>();  // a const object can't be bound to a non const member function
+
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
+
+			Details::StoreResult<void>(result, [&]() -> void { return (obj->*mMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
 		MemFunPtr mMemFunPtr;
@@ -212,35 +634,44 @@ namespace Reflect
 
 	public:
 		ConstMemberFunction(ConstMemFunPtr constMemFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mConstMemFunPtr(constMemFun) {}
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(const C&, Args...)>(), reinterpret_cast<Thunk>(&ConstMemberFunction::Call)), mConstMemFunPtr(constMemFun) {}
 
 	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
+		static Ret Call(const Function *function, const C &object, Args... args)
+		{
+			return (object.*static_cast<const ConstMemberFunction*>(function)->mConstMemFunPtr)(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
+			return Details::InvokeBatch<const C, Ret, Args...>(&ConstMemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			if (C *obj = object.TryCast<C>(); obj && (std::get<indices>(argsTuple) && ...))  // object is valid and all arguments are valid 
-				if constexpr (std::is_void<Ret>::value)
-				{
-					(obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-					return Any();
-				}
-				else
-					if constexpr (std::is_reference_v<Ret>)
-						return AnyRef((obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...));
-					else
-						return (obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
+
+			const C *obj = object.TryCast<const C>();
+
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
+
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return (obj->*mConstMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
 		ConstMemFunPtr mConstMemFunPtr;
@@ -0,0 +1,133 @@
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+#include "Span.hpp"
+
+namespace Reflect
+{
+
+	// FNV-1a hash of a name, usable at compile time
+	constexpr std::uint64_t HashName(std::string_view name)
+	{
+		std::uint64_t hash = 14695981039346656037ULL;
+
+		for (char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	/*
+	* a name together with its hash, lookups by HashedName don't hash the name:
+	* static constexpr HashedName position("position") hashes it at compile time
+	*/
+	struct HashedName
+	{
+		constexpr explicit HashedName(std::string_view name) : Name(name), Hash(HashName(name)) {}
+
+		std::string_view Name;
+		std::uint64_t Hash;
+	};
+
+	/*
+	* identifier of a type, stable across runs of programs built with the same compiler: it can be
+	* stored or sent in place of the type name (Resolve(TypeId) returns the type descriptor)
+	*/
+	struct TypeId
+	{
+		std::uint64_t Value;
+
+		constexpr bool operator==(TypeId other) const { return Value == other.Value; }
+		constexpr bool operator!=(TypeId other) const { return Value != other.Value; }
+	};
+
+	namespace Details
+	{
+
+		// the function signature contains the name of the type as spelled by the compiler
+		template <typename Type>
+		constexpr TypeId GetTypeId()
+		{
+#if defined(_MSC_VER)
+			return TypeId{ HashName(__FUNCSIG__) };
+#else
+			return TypeId{ HashName(__PRETTY_FUNCTION__) };
+#endif
+		}
+
+		/*
+		* open addressing hash table that indexes named meta objects (T must have a GetName member function),
+		* it's built once from the meta objects and used for lookups only
+		*/
+		template <typename T>
+		class NameIndex
+		{
+		public:
+			void Build(Span<T* const> objects)
+			{
+				mSlots.assign(GetCapacity(objects.size()), Slot{ 0U, nullptr });
+
+				for (auto *object : objects)  // if more objects have the same name the first one is found
+				{
+					std::uint64_t hash = HashName(object->GetName());
+
+					if (!Find(HashedName(object->GetName())))
+					{
+						std::size_t index = hash & (mSlots.size() - 1U);
+
+						while (mSlots[index].Object)
+							index = (index + 1U) & (mSlots.size() - 1U);
+
+						mSlots[index] = Slot{ hash, object };
+					}
+				}
+			}
+
+			T *Find(const HashedName &name) const
+			{
+				if (mSlots.empty())
+					return nullptr;
+
+				for (std::size_t index = name.Hash & (mSlots.size() - 1U); mSlots[index].Object; index = (index + 1U) & (mSlots.size() - 1U))
+					if (mSlots[index].Hash == name.Hash && mSlots[index].Object->GetName() == name.Name)
+						return mSlots[index].Object;
+
+				return nullptr;
+			}
+
+		private:
+			struct Slot
+			{
+				std::uint64_t Hash;
+				T *Object;  // nullptr if the slot is empty
+			};
+
+			// at most half the slots are used (capacity is a power of 2)
+			static std::size_t GetCapacity(std::size_t size)
+			{
+				if (size == 0U)
+					return 0U;
+
+				std::size_t capacity = 4U;
+
+				while (capacity < size * 2U)
+					capacity *= 2U;
+
+				return capacity;
+			}
+
+			std::vector<Slot> mSlots;
+		};
+
+	}  // namespace Details
+
+}  // namespace Reflect
+
+#endif  // HASH_H
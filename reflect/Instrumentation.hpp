@@ -0,0 +1,340 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+* instrumentation of reflected calls is opt-in: build with -DREFLECT_INSTRUMENTATION (in all the translation units)
+* to count calls, latency, failed casts, conversions and Any heap allocations per meta object (function, constructor,
+* data member and conversion), without it the instrumentation macros compile to nothing and no stats are collected
+*/
+
+#ifdef REFLECT_INSTRUMENTATION
+	#include <atomic>
+	#include <chrono>
+	#include <memory>
+	#include <mutex>
+	#include <ostream>
+	#include <algorithm>
+#else
+	#include <iosfwd>
+#endif
+
+namespace Reflect
+{
+
+	// aggregated stats of a meta object
+	struct CallStats
+	{
+		static constexpr std::size_t HISTOGRAM_BUCKETS = 24;  // bucket i counts calls that took [2^i, 2^(i+1)) ns (the last one counts all the slower calls)
+
+		std::uint64_t Calls = 0;
+		std::uint64_t FailedCasts = 0;     // calls that failed because the object or an argument couldn't be cast or converted
+		std::uint64_t Conversions = 0;     // conversions performed during the calls (or calls of a conversion)
+		std::uint64_t HeapSpills = 0;      // objects that didn't fit an Any's SBO buffer during the calls
+		std::uint64_t Nanoseconds = 0;     // cumulative latency
+		std::uint64_t Histogram[HISTOGRAM_BUCKETS] = {};
+	};
+
+	struct MetaObjectStats
+	{
+		std::string TypeName;     // name of the type the meta object belongs to
+		std::string Kind;         // function, constructor, data member or conversion
+		std::string Description;  // name (or signature) of the meta object
+		CallStats Stats;
+	};
+
+#ifdef REFLECT_INSTRUMENTATION
+
+	namespace Details
+	{
+
+		using StatsId = std::size_t;
+
+		// counters of a meta object for a single thread: only the owning thread writes them, any thread can read them
+		struct MetaCounters
+		{
+			std::atomic<std::uint64_t> Calls{ 0 };
+			std::atomic<std::uint64_t> FailedCasts{ 0 };
+			std::atomic<std::uint64_t> Conversions{ 0 };
+			std::atomic<std::uint64_t> HeapSpills{ 0 };
+			std::atomic<std::uint64_t> Nanoseconds{ 0 };
+			std::atomic<std::uint64_t> Histogram[CallStats::HISTOGRAM_BUCKETS] = {};
+		};
+
+		// single writer: a relaxed load and store instead of an atomic read-modify-write
+		inline void AddCount(std::atomic<std::uint64_t> &counter, std::uint64_t count)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+
+		/*
+		* counters of all the meta objects for a single thread, allocated in chunks on first use
+		* (chunks are never moved, so that other threads can aggregate the counters while the owner updates them)
+		*/
+		class ThreadStats
+		{
+		public:
+			static constexpr std::size_t CHUNK_SIZE = 64;
+			static constexpr std::size_t MAX_CHUNKS = 1024;  // meta objects beyond CHUNK_SIZE * MAX_CHUNKS aren't tracked
+
+			~ThreadStats()
+			{
+				for (auto &chunk : mChunks)
+					delete[] chunk.load(std::memory_order_relaxed);
+			}
+
+			MetaCounters *Get(StatsId id)
+			{
+				if (id >= CHUNK_SIZE * MAX_CHUNKS)
+					return nullptr;
+
+				std::atomic<MetaCounters*> &chunk = mChunks[id / CHUNK_SIZE];
+				MetaCounters *counters = chunk.load(std::memory_order_relaxed);
+
+				if (!counters)
+				{
+					counters = new MetaCounters[CHUNK_SIZE];
+					chunk.store(counters, std::memory_order_release);
+				}
+
+				return counters + id % CHUNK_SIZE;
+			}
+
+			const MetaCounters *Find(StatsId id) const
+			{
+				if (id >= CHUNK_SIZE * MAX_CHUNKS)
+					return nullptr;
+
+				const MetaCounters *counters = mChunks[id / CHUNK_SIZE].load(std::memory_order_acquire);
+
+				return counters ? counters + id % CHUNK_SIZE : nullptr;
+			}
+
+			// running totals of the thread, a call is charged the difference between its start and its end
+			std::uint64_t Conversions = 0;
+			std::uint64_t HeapSpills = 0;
+
+		private:
+			std::atomic<MetaCounters*> mChunks[MAX_CHUNKS] = {};
+		};
+
+		class Instrumentation
+		{
+		public:
+			// fills the type name, kind and description of a meta object when the stats are collected
+			using Describe = void(*)(const void *metaObject, MetaObjectStats &stats);
+
+			StatsId Register(const void *metaObject, Describe describe)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				mEntries.push_back({ metaObject, describe });
+
+				return mEntries.size() - 1;
+			}
+
+			ThreadStats &GetThreadStats()
+			{
+				thread_local ThreadStats *threadStats = nullptr;
+
+				if (!threadStats)  // the stats of a thread outlive it, so that its counts are still reported
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+
+					mThreads.push_back(std::make_unique<ThreadStats>());
+					threadStats = mThreads.back().get();
+				}
+
+				return *threadStats;
+			}
+
+			std::vector<MetaObjectStats> Collect()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				std::vector<MetaObjectStats> collected;
+
+				for (StatsId id = 0; id < mEntries.size(); ++id)
+				{
+					MetaObjectStats stats;
+
+					for (auto &thread : mThreads)
+						if (const MetaCounters *counters = thread->Find(id))
+						{
+							stats.Stats.Calls += counters->Calls.load(std::memory_order_relaxed);
+							stats.Stats.FailedCasts += counters->FailedCasts.load(std::memory_order_relaxed);
+							stats.Stats.Conversions += counters->Conversions.load(std::memory_order_relaxed);
+							stats.Stats.HeapSpills += counters->HeapSpills.load(std::memory_order_relaxed);
+							stats.Stats.Nanoseconds += counters->Nanoseconds.load(std::memory_order_relaxed);
+
+							for (std::size_t i = 0; i < CallStats::HISTOGRAM_BUCKETS; ++i)
+								stats.Stats.Histogram[i] += counters->Histogram[i].load(std::memory_order_relaxed);
+						}
+
+					if (stats.Stats.Calls == 0)
+						continue;
+
+					mEntries[id].DescribeMetaObject(mEntries[id].MetaObject, stats);
+					collected.push_back(std::move(stats));
+				}
+
+				return collected;
+			}
+
+		private:
+			struct Entry
+			{
+				const void *MetaObject;
+				Describe DescribeMetaObject;
+			};
+
+			std::mutex mMutex;
+			std::vector<Entry> mEntries;  // indexed by stats id
+			std::vector<std::unique_ptr<ThreadStats>> mThreads;
+		};
+
+		inline Instrumentation &GetInstrumentation()
+		{
+			static Instrumentation instrumentation;
+
+			return instrumentation;
+		}
+
+		/*
+		* CallScope measures a call (or a batch of calls) of a meta object: latency,
+		* conversions and Any heap allocations made by the thread while the scope is alive
+		*/
+		class CallScope
+		{
+		public:
+			explicit CallScope(StatsId id)
+				: mId(id), mThreadStats(GetInstrumentation().GetThreadStats()), mConversions(mThreadStats.Conversions), mHeapSpills(mThreadStats.HeapSpills),
+				mStart(std::chrono::steady_clock::now()) {}
+
+			CallScope(const CallScope&) = delete;
+			CallScope &operator=(const CallScope&) = delete;
+
+			~CallScope()
+			{
+				std::uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count();
+
+				MetaCounters *counters = mThreadStats.Get(mId);
+
+				if (!counters)
+					return;
+
+				AddCount(counters->Calls, mCalls);
+				AddCount(counters->FailedCasts, mFailedCasts);
+				AddCount(counters->Conversions, mThreadStats.Conversions - mConversions);
+				AddCount(counters->HeapSpills, mThreadStats.HeapSpills - mHeapSpills);
+				AddCount(counters->Nanoseconds, nanoseconds);
+
+				std::uint64_t perCall = mCalls ? nanoseconds / mCalls : nanoseconds;
+				std::size_t bucket = 0;
+
+				while (perCall > 1 && bucket < CallStats::HISTOGRAM_BUCKETS - 1)
+				{
+					perCall >>= 1;
+					++bucket;
+				}
+
+				AddCount(counters->Histogram[bucket], mCalls);
+			}
+
+			void SetResult(bool isSuccess)
+			{
+				mFailedCasts = isSuccess ? 0 : 1;
+			}
+
+			void SetBatchResult(std::size_t calls, std::size_t successfulCalls)
+			{
+				mCalls = calls;
+				mFailedCasts = calls - successfulCalls;
+			}
+
+		private:
+			StatsId mId;
+			ThreadStats &mThreadStats;
+			std::uint64_t mConversions;
+			std::uint64_t mHeapSpills;
+			std::chrono::steady_clock::time_point mStart;
+			std::uint64_t mCalls = 1;
+			std::uint64_t mFailedCasts = 0;
+		};
+
+	}  // namespace Details
+
+	// stats of the meta objects called at least once, sorted by type name
+	inline std::vector<MetaObjectStats> CollectStats()
+	{
+		std::vector<MetaObjectStats> stats = Details::GetInstrumentation().Collect();
+
+		std::stable_sort(stats.begin(), stats.end(), [](const MetaObjectStats &a, const MetaObjectStats &b) { return a.TypeName < b.TypeName; });
+
+		return stats;
+	}
+
+	inline void DumpStats(std::ostream &os)
+	{
+		std::string typeName;
+		bool isFirst = true;
+
+		for (auto &metaObject : CollectStats())
+		{
+			if (isFirst || metaObject.TypeName != typeName)
+			{
+				typeName = metaObject.TypeName;
+				isFirst = false;
+
+				os << (typeName.empty() ? "(free functions)" : typeName) << '\n';
+			}
+
+			const CallStats &stats = metaObject.Stats;
+
+			os << "  " << metaObject.Kind << ' ' << metaObject.Description << ": " << stats.Calls << " calls, " << stats.FailedCasts << " failed casts, "
+				<< stats.Conversions << " conversions, " << stats.HeapSpills << " heap spills, " << stats.Nanoseconds / (stats.Calls ? stats.Calls : 1) << " ns/call\n";
+
+			os << "    latency (ns):";
+
+			for (std::size_t i = 0; i < CallStats::HISTOGRAM_BUCKETS; ++i)
+				if (stats.Histogram[i])
+					os << " [" << (std::uint64_t(1) << i) << ", " << (i + 1 < CallStats::HISTOGRAM_BUCKETS ? std::to_string(std::uint64_t(1) << (i + 1)) : std::string("inf")) << "): " << stats.Histogram[i];
+
+			os << '\n';
+		}
+	}
+
+	// the stats id of a meta object (a data member of its base class)
+	#define REFLECT_STATS_ID(describe) ::Reflect::Details::StatsId mStatsId = ::Reflect::Details::GetInstrumentation().Register(this, describe);
+
+	#define REFLECT_CALL_SCOPE(scope) ::Reflect::Details::CallScope scope(mStatsId)
+	#define REFLECT_CALL_RESULT(scope, isSuccess) scope.SetResult(isSuccess)
+	#define REFLECT_BATCH_RESULT(scope, calls, successfulCalls) scope.SetBatchResult(calls, successfulCalls)
+	#define REFLECT_COUNT_CONVERSION() ++::Reflect::Details::GetInstrumentation().GetThreadStats().Conversions
+	#define REFLECT_COUNT_HEAP_SPILL() ++::Reflect::Details::GetInstrumentation().GetThreadStats().HeapSpills
+
+#else
+
+	inline std::vector<MetaObjectStats> CollectStats()
+	{
+		return {};
+	}
+
+	inline void DumpStats(std::ostream&) {}
+
+	#define REFLECT_STATS_ID(describe)
+	#define REFLECT_CALL_SCOPE(scope) ((void)0)
+	#define REFLECT_CALL_RESULT(scope, isSuccess) ((void)0)
+	#define REFLECT_BATCH_RESULT(scope, calls, successfulCalls) ((void)0)
+	#define REFLECT_COUNT_CONVERSION() ((void)0)
+	#define REFLECT_COUNT_HEAP_SPILL() ((void)0)
+
+#endif  // REFLECT_INSTRUMENTATION
+
+}  // namespace Reflect
+
+#endif  // INSTRUMENTATION_H
@@ -0,0 +1,111 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include "Reflect.hpp"
+#include <cstddef>
+#include <atomic>
+#include <vector>
+#include "ThreadPool.hpp"
+#include "Span.hpp"
+#include "Any.hpp"
+#include "Function.hpp"
+#include "DataMember.hpp"
+#include "ConversionPlan.hpp"
+
+namespace Reflect
+{
+
+	/*
+	* parallel versions of batch invocation and data member update: the objects are split in chunks
+	* of grainSize objects that run on the pool's threads, each chunk is a batch (casts and conversions
+	* are resolved once per chunk), arguments shared by all the objects must not be modified by the function
+	*/
+
+	template <typename T, typename... Args>
+	std::size_t ParallelInvoke(ThreadPool &pool, std::size_t grainSize, const Function &function, Span<T> objects, Span<Any> results, Args&&... args)
+	{
+		if (!results.empty() && results.size() < objects.size())
+			return 0;
+
+		std::atomic<std::size_t> calls{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			Span<Any> chunkResults = results.empty() ? results : results.subspan(begin, end - begin);
+			calls += function.InvokeBatch(objects.subspan(begin, end - begin), chunkResults, args...);
+		});
+
+		return calls;
+	}
+
+	template <typename T, typename... Columns>
+	std::size_t ParallelInvokeColumns(ThreadPool &pool, std::size_t grainSize, const Function &function, Span<T> objects, Span<Any> results, Span<Columns>... columns)
+	{
+		if ((!results.empty() && results.size() < objects.size()) || ((columns.size() < objects.size()) || ...))
+			return 0;
+
+		std::atomic<std::size_t> calls{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			Span<Any> chunkResults = results.empty() ? results : results.subspan(begin, end - begin);
+			calls += function.InvokeBatchColumns(objects.subspan(begin, end - begin), chunkResults, columns.subspan(begin, end - begin)...);
+		});
+
+		return calls;
+	}
+
+	/*
+	* sets the data member of each object to value, cast or converted once for all the objects (throws BadCastException
+	* if it can't be); each chunk is scattered like a batch, objects that can't be cast are skipped. Returns the number
+	* of objects set
+	*/
+	template <typename T>
+	std::size_t ParallelSet(ThreadPool &pool, std::size_t grainSize, const DataMember &dataMember, Span<T> objects, const Any &value)
+	{
+		Any converted;
+		const void *casted = Details::CastOrConvert(value, dataMember.GetType(), converted);
+
+		if (!casted)
+			throw BadCastException(dataMember.GetType(), value.GetType(), "value:");
+
+		std::atomic<std::size_t> set{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			set += dataMember.Fill(objects.subspan(begin, end - begin), casted);
+		});
+
+		return set;
+	}
+
+	/*
+	* sets the data member of the i-th object to the i-th value (throws BadCastException if a value can't be cast or converted),
+	* values are cast or converted once each, then each chunk is scattered like a batch
+	*/
+	template <typename T>
+	std::size_t ParallelSetColumn(ThreadPool &pool, std::size_t grainSize, const DataMember &dataMember, Span<T> objects, Span<const Any> values)
+	{
+		if (values.size() < objects.size())
+			return 0;
+
+		std::atomic<std::size_t> set{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			std::vector<const void*> casted(end - begin);
+			std::vector<Any> converted(end - begin);  // stay empty unless a value needs a conversion
+
+			for (std::size_t i = begin; i < end; ++i)
+				if (!(casted[i - begin] = Details::CastOrConvert(values[i], dataMember.GetType(), converted[i - begin])))
+					throw BadCastException(dataMember.GetType(), values[i].GetType(), "value:");
+
+			set += dataMember.ScatterIndirect(objects.subspan(begin, end - begin), Span<const void* const>(casted));
+		});
+
+		return set;
+	}
+
+}  // namespace Reflect
+
+#endif  // PARALLEL_H
@@ -13,7 +13,8 @@ namespace Reflect
 	/*
 	* Reflect takes a string which is the mapped name of the
 	* reflected type and returns a TypeFactory, which can be
-	* used to add meta objects to the type descriptor
+	* used to add meta objects to the type descriptor (a type
+	* keeps the name it's first registered with)
 	*/
 
 	template <typename Type>
@@ -23,10 +24,11 @@ namespace Reflect
 	}
 
 	/*
-	* three ways to get the type descriptor of a type:
+	* four ways to get the type descriptor of a type:
 	* 1. with a template type parameter
 	* 2. with the name of the type (a string)
-	* 3. with an instance of the object
+	* 3. with the id of the type
+	* 4. with an instance of the object
 	*
 	* each function calls the corresponding internal Resolve and returns a const pointer to the type descriptor
 	*/
@@ -37,7 +39,7 @@ namespace Reflect
 		return Details::Resolve<Type>();
 	}
 
-	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string>::value>::type>
+	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string>::value && !std::is_same<Details::RawType<T>, HashedName>::value && !std::is_same<Details::RawType<T>, TypeId>::value>::type>
 	const TypeDescriptor *Resolve(T &&object)
 	{
 		return Details::Resolve(std::forward<T>(object));
@@ -45,10 +47,24 @@ namespace Reflect
 	
 	inline const TypeDescriptor *Resolve(const std::string &name)
 	{
-		if (auto it = Details::GetTypeRegistry().find(name); it != Details::GetTypeRegistry().end())
-			return it->second;
+		return Details::GetTypeRegistry().Find(HashedName(name));
+	}
 
-		return nullptr;
+	inline const TypeDescriptor *Resolve(const HashedName &name)
+	{
+		return Details::GetTypeRegistry().Find(name);
+	}
+
+	inline const TypeDescriptor *Resolve(TypeId id)
+	{
+		return Details::GetTypeRegistry().Find(id);
+	}
+
+	// the id of a type is computed at compile time
+	template <typename Type>
+	constexpr TypeId GetTypeId()
+	{
+		return Details::GetTypeId<Details::RawType<Type>>();
 	}
 
 }  // namespace Reflect
@@ -0,0 +1,50 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
+
+namespace Reflect
+{
+
+	/*
+	* Span is a non owning view over a contiguous sequence of objects (like C++20 std::span),
+	* it is returned by type descriptors to access meta objects without copying them
+	*/
+	template <typename T>
+	class Span
+	{
+	public:
+		Span() : mData(nullptr), mSize(0U) {}
+
+		Span(T *data, std::size_t size) : mData(data), mSize(size) {}
+
+		template <std::size_t N>
+		Span(T (&array)[N]) : mData(array), mSize(N) {}
+
+		template <typename Container, typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+		Span(Container &container) : mData(container.data()), mSize(container.size()) {}
+
+		T *begin() const { return mData; }
+		T *end() const { return mData + mSize; }
+
+		T *data() const { return mData; }
+		std::size_t size() const { return mSize; }
+		bool empty() const { return mSize == 0U; }
+
+		T &operator[](std::size_t index) const { return mData[index]; }
+
+		Span subspan(std::size_t offset, std::size_t count) const { return Span(mData + offset, count); }
+
+		// copy the elements into a vector
+		operator std::vector<std::remove_const_t<T>>() const { return std::vector<std::remove_const_t<T>>(begin(), end()); }
+
+	private:
+		T *mData;
+		std::size_t mSize;
+	};
+
+}  // namespace Reflect
+
+#endif  // SPAN_H
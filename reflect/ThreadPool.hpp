@@ -0,0 +1,230 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+namespace Reflect
+{
+
+	/*
+	* ThreadPool is a small work stealing pool used to run reflected calls in parallel:
+	* each worker owns a queue of tasks, it pops tasks from the back of its own queue
+	* and steals tasks from the front of the other workers' queues when its queue is empty,
+	* the thread that starts a parallel loop runs tasks as well until the loop is done
+	*/
+	class ThreadPool
+	{
+	public:
+		// threadCount includes the calling thread (a pool with 1 thread runs everything on the calling thread)
+		explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+		{
+			std::size_t workerCount = threadCount > 1 ? threadCount - 1 : 0;
+
+			for (std::size_t i = 0; i < workerCount; ++i)
+				mQueues.push_back(std::make_unique<Queue>());
+
+			for (std::size_t i = 0; i < workerCount; ++i)
+				mWorkers.emplace_back([this, i]() { WorkerLoop(i); });
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool &operator=(const ThreadPool&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mWakeMutex);
+				mStop = true;
+			}
+
+			mWake.notify_all();
+
+			for (auto &worker : mWorkers)
+				worker.join();
+		}
+
+		std::size_t GetThreadCount() const { return mWorkers.size() + 1; }
+
+		/*
+		* splits [0, count) in chunks of grainSize elements and calls body(begin, end) for each chunk on the pool's threads,
+		* returns when all the chunks are done (the first exception thrown by body is rethrown)
+		*/
+		template <typename Body>
+		void ParallelFor(std::size_t count, std::size_t grainSize, Body &&body)
+		{
+			grainSize = std::max<std::size_t>(grainSize, 1U);
+
+			std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+			if (chunkCount == 0)
+				return;
+
+			if (mWorkers.empty() || chunkCount == 1)
+			{
+				body(std::size_t(0), count);
+
+				return;
+			}
+
+			Job job;
+			job.Body = [](void *context, std::size_t begin, std::size_t end) { (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end); };
+			job.Context = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+			job.Remaining = chunkCount;
+
+			{
+				std::lock_guard<std::mutex> lock(mWakeMutex);
+				mPending += chunkCount;  // counted before the tasks are queued so that it never goes below zero
+			}
+
+			for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				Queue &queue = *mQueues[chunk % mQueues.size()];
+				std::lock_guard<std::mutex> lock(queue.Mutex);
+				queue.Tasks.push_back({ &job, chunk * grainSize, std::min(count, (chunk + 1) * grainSize) });
+			}
+
+			mWake.notify_all();
+
+			// help the workers until no task is left, then wait for the chunks still running
+			Task task;
+			while (job.Remaining.load(std::memory_order_acquire) != 0 && Steal(mQueues.size(), task))
+				Run(task);
+
+			std::unique_lock<std::mutex> lock(job.Mutex);
+			job.Done.wait(lock, [&job]() { return job.Remaining.load(std::memory_order_acquire) == 0; });
+
+			if (job.Error)
+				std::rethrow_exception(job.Error);
+		}
+
+	private:
+		struct Job
+		{
+			void (*Body)(void *context, std::size_t begin, std::size_t end);
+			void *Context;
+			std::atomic<std::size_t> Remaining;
+			std::exception_ptr Error;
+			std::mutex Mutex;
+			std::condition_variable Done;
+		};
+
+		struct Task
+		{
+			Job *ParentJob;
+			std::size_t Begin;
+			std::size_t End;
+		};
+
+		struct Queue
+		{
+			std::mutex Mutex;
+			std::deque<Task> Tasks;
+		};
+
+		void WorkerLoop(std::size_t index)
+		{
+			Task task;
+
+			while (true)
+			{
+				if (Pop(index, task) || Steal(index, task))
+				{
+					Run(task);
+
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(mWakeMutex);
+				mWake.wait(lock, [this]() { return mStop || mPending != 0; });
+
+				if (mStop)
+					return;
+			}
+		}
+
+		// pop from the back of the worker's own queue
+		bool Pop(std::size_t index, Task &task)
+		{
+			Queue &queue = *mQueues[index];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+
+			if (queue.Tasks.empty())
+				return false;
+
+			task = queue.Tasks.back();
+			queue.Tasks.pop_back();
+			--mPending;
+
+			return true;
+		}
+
+		// steal from the front of the other queues (index is the thief's own queue, or the number of queues for the calling thread)
+		bool Steal(std::size_t index, Task &task)
+		{
+			for (std::size_t i = 1; i <= mQueues.size(); ++i)
+			{
+				std::size_t victim = (index + i) % mQueues.size();
+
+				if (victim == index)
+					continue;
+
+				Queue &queue = *mQueues[victim];
+				std::lock_guard<std::mutex> lock(queue.Mutex);
+
+				if (queue.Tasks.empty())
+					continue;
+
+				task = queue.Tasks.front();
+				queue.Tasks.pop_front();
+				--mPending;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		void Run(const Task &task)
+		{
+			Job &job = *task.ParentJob;
+
+			try
+			{
+				job.Body(job.Context, task.Begin, task.End);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(job.Mutex);
+
+				if (!job.Error)
+					job.Error = std::current_exception();
+			}
+
+			// the job lives on the stack of the thread waiting for it, it's decremented under the lock so that it's not destroyed before the notification
+			std::lock_guard<std::mutex> lock(job.Mutex);
+
+			if (job.Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)  // last chunk: wake the thread waiting for the job
+				job.Done.notify_all();
+		}
+
+		std::vector<std::unique_ptr<Queue>> mQueues;
+		std::vector<std::thread> mWorkers;
+
+		std::mutex mWakeMutex;
+		std::condition_variable mWake;
+		std::atomic<std::size_t> mPending{ 0 };
+		bool mStop = false;
+	};
+
+}  // namespace Reflect
+
+#endif  // THREAD_POOL_H
@@ -3,8 +3,15 @@
 
 #include <string>
 #include <vector>
-#include <map>
 #include <type_traits>
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include "Span.hpp"
+#include "Hash.hpp"
+#include "Instrumentation.hpp"
 
 namespace Reflect
 {
@@ -31,14 +38,49 @@ namespace Reflect
 		template <typename Type>
 		TypeDescriptor *Resolve(Type &&);
 
+		template <typename Type>
+		TypeDescriptor *InitTypeDescriptor();
+
+		class ConversionPlanCache;
+
+		template <typename, bool>
+		class BatchArg;
+
+		// entry of the flattened table of all the direct and indirect bases of a type
+		struct BaseCast
+		{
+			const TypeDescriptor *Type;
+			std::ptrdiff_t Offset;      // pointer adjustment from the derived object (if Step is nullptr)
+			Base *Step;                 // base reached through a virtual base: cast applied to the From type
+			const TypeDescriptor *From;
+		};
+
+		/*
+		* the meta objects of a type as seen by readers: an immutable snapshot built on first use
+		* and rebuilt after new meta objects are registered for the type or one of its bases
+		*/
+		struct TypeTables
+		{
+			std::vector<Base*> Bases;
+			std::vector<Conversion*> Conversions;
+			std::vector<Constructor*> Constructors;
+			std::vector<DataMember*> DataMembers;    // own and inherited
+			std::vector<Function*> MemberFunctions;  // own and inherited
+			std::vector<BaseCast> BaseCasts;         // direct and indirect bases, sorted by type
+			NameIndex<DataMember> DataMemberIndex;
+			NameIndex<Function> MemberFunctionIndex;
+		};
+
 	}	// namespace Details
 
 	class TypeDescriptor
 	{
 		template <typename> friend class TypeFactory;
 
-		template <typename Type> friend TypeDescriptor *Details::Resolve();
-		template <typename Type> friend TypeDescriptor *Details::Resolve(Type &&);
+		template <typename Type> friend TypeDescriptor *Details::InitTypeDescriptor();
+		friend class Details::ConversionPlanCache;
+		template <typename, bool> friend class Details::BatchArg;
+		friend class DataMember;
 
 	public:
 		template <typename Type, typename... Args>
@@ -70,34 +112,52 @@ namespace Reflect
 
 		std::string const &GetName() const;
 
-		//std::size_t GetSize() const;
+		TypeId GetId() const;
+
+		std::size_t GetSize() const;
+
+		/*
+		* meta objects are accessed through non owning views: data members and member functions
+		* include those inherited from base classes. Types can be registered and resolved
+		* concurrently, registration is serialized and reads are lock free
+		*/
 
-		std::vector<Constructor*> GetConstructors() const;
+		Span<Constructor* const> GetConstructors() const;
 
 		template <typename... Args>
 		const Constructor *GetConstructor() const;
 
-		std::vector<Base*> GetBases() const;
+		Span<Base* const> GetBases() const;
 
 		template <typename B>
 		Base *GetBase() const;
 
-		std::vector<DataMember*> GetDataMembers() const;
+		bool HasBase(const TypeDescriptor *base) const;  // direct or indirect base
 
-		DataMember *GetDataMember(const std::string &name) const;
+		void *Cast(void *object, const TypeDescriptor *to) const;  // cast to the same type or to a direct or indirect base
 
-		std::vector<Function*> GetMemberFunctions() const;
+		Span<DataMember* const> GetDataMembers() const;
 
-		const Function *GetMemberFunction(const std::string &name) const;
+		DataMember *GetDataMember(std::string_view name) const;
 
-		std::vector<Conversion*> GetConversions() const;
+		DataMember *GetDataMember(const HashedName &name) const;
+
+		Span<Function* const> GetMemberFunctions() const;
+
+		const Function *GetMemberFunction(std::string_view name) const;
+
+		const Function *GetMemberFunction(const HashedName &name) const;
+
+		Span<Conversion* const> GetConversions() const;
 
 		template <typename To>
 		Conversion *GetConversion() const;
 
 	private:
-		std::string mName;
+		std::atomic<const std::string*> mName{ nullptr };  // points to mNameStorage once the type is registered, the name never changes afterwards
+		std::string mNameStorage;
 		std::size_t mSize;
+		TypeId mId;
 
 		std::vector<Base*> mBases;
 		std::vector<Conversion*> mConversions;
@@ -105,6 +165,18 @@ namespace Reflect
 		std::vector<DataMember*> mDataMembers;
 		std::vector<Function*> mMemberFunctions;
 
+		// tables published to readers, nullptr until first used or after being invalidated
+		mutable std::atomic<const Details::TypeTables*> mTables{ nullptr };
+		mutable bool mHasTables = false;  // (guarded by the registration mutex)
+
+		const Details::TypeTables &GetTables() const;
+		const Details::TypeTables &BuildTables() const;
+		void CollectBases(std::vector<Details::BaseCast> &baseCasts, const TypeDescriptor *derived, std::ptrdiff_t offset, bool isFixedOffset) const;
+		const Details::BaseCast *FindBaseCast(const TypeDescriptor *base) const;
+
+		static const Details::BaseCast *FindBaseCast(const Details::TypeTables &tables, const TypeDescriptor *base);
+		static void InvalidateTables(const TypeDescriptor *changed, bool areCastsChanged = false);
+
 		// C++ primary type categories
 		bool mIsVoid;
 		bool mIsIntegral;
@@ -139,17 +211,146 @@ namespace Reflect
 			return typeDescriptor;
 		}
 
-		template <typename Type>
-		TypeDescriptor *&GetTypeDescriptorPtr()
+		// serializes registration of types and meta objects (reads don't lock)
+		inline std::recursive_mutex &GetRegistrationMutex()
 		{
-			static TypeDescriptor *typeDescriptorPtr = nullptr;  // single instance of type descriptor ptr per reflected type
+			static std::recursive_mutex registrationMutex;
 
-			return typeDescriptorPtr;
+			return registrationMutex;
 		}
 
-		inline auto &GetTypeRegistry()
+		// bumped when a base or a conversion is registered: argument types that couldn't be cast may be castable afterwards
+		inline std::atomic<std::uint64_t> &GetCastsGeneration()
+		{
+			static std::atomic<std::uint64_t> castsGeneration{ 0 };
+
+			return castsGeneration;
+		}
+
+		/*
+		* all the tables ever published: lock free readers and the views returned by the accessors of a type descriptor may still
+		* refer to replaced tables, so they are never freed. Tables are replaced only when a type or one of its bases is changed
+		* after its tables were built (by the first lookup): one snapshot is retained per such change and per type derived from
+		* the changed one, none if the types are registered before being looked up (guarded by the registration mutex)
+		*/
+		inline std::vector<std::unique_ptr<TypeTables>> &GetTypeTablesStorage()
+		{
+			static std::vector<std::unique_ptr<TypeTables>> typeTablesStorage;
+
+			return typeTablesStorage;
+		}
+
+		// type descriptors that have published tables (guarded by the registration mutex)
+		inline std::vector<const TypeDescriptor*> &GetTypesWithTables()
+		{
+			static std::vector<const TypeDescriptor*> typesWithTables;
+
+			return typesWithTables;
+		}
+
+		/*
+		* registry of the reflected types, indexed by type id and by name with open addressing
+		* hash tables: insertions are serialized by the registration mutex, lookups are lock free
+		* (slots are published with atomic stores, tables are never freed when they grow)
+		*/
+		class TypeRegistry
+		{
+		public:
+			void Insert(TypeDescriptor *typeDescriptor)
+			{
+				InsertSlot(mIds, typeDescriptor->GetId().Value, typeDescriptor, [typeDescriptor](const TypeDescriptor *type) { return type == typeDescriptor; });
+				InsertSlot(mNames, HashName(typeDescriptor->GetName()), typeDescriptor, [typeDescriptor](const TypeDescriptor *type) { return type->GetName() == typeDescriptor->GetName(); });
+			}
+
+			TypeDescriptor *Find(TypeId id) const
+			{
+				return FindSlot(mIds, id.Value, [id](const TypeDescriptor *type) { return type->GetId() == id; });
+			}
+
+			TypeDescriptor *Find(const HashedName &name) const
+			{
+				return FindSlot(mNames, name.Hash, [&name](const TypeDescriptor *type) { return type->GetName() == name.Name; });
+			}
+
+		private:
+			struct Slot
+			{
+				std::atomic<std::uint64_t> Hash;
+				std::atomic<TypeDescriptor*> Type;  // nullptr if the slot is empty
+			};
+
+			struct Table
+			{
+				explicit Table(std::size_t capacity) : Capacity(capacity), Size(0U), Slots(new Slot[capacity]()) {}
+
+				std::size_t Capacity;  // power of 2
+				std::size_t Size;
+				std::unique_ptr<Slot[]> Slots;
+			};
+
+			// a slot equal to an existing one is replaced
+			template <typename Equal>
+			void InsertSlot(std::atomic<Table*> &tablePtr, std::uint64_t hash, TypeDescriptor *type, Equal equal)
+			{
+				Table *table = tablePtr.load(std::memory_order_relaxed);
+
+				if (!table || (table->Size + 1U) * 2U > table->Capacity)  // at most half the slots are used
+				{
+					mTables.push_back(std::make_unique<Table>(table ? table->Capacity * 2U : 16U));
+					Table *newTable = mTables.back().get();
+
+					if (table)
+						for (std::size_t index = 0U; index < table->Capacity; ++index)
+							if (TypeDescriptor *oldType = table->Slots[index].Type.load(std::memory_order_relaxed))
+								InsertSlot(*newTable, table->Slots[index].Hash.load(std::memory_order_relaxed), oldType, [](const TypeDescriptor*) { return false; });
+
+					tablePtr.store(newTable, std::memory_order_release);
+					table = newTable;
+				}
+
+				InsertSlot(*table, hash, type, equal);
+			}
+
+			template <typename Equal>
+			static void InsertSlot(Table &table, std::uint64_t hash, TypeDescriptor *type, Equal equal)
+			{
+				std::size_t index = hash & (table.Capacity - 1U);
+
+				for (; TypeDescriptor *slotType = table.Slots[index].Type.load(std::memory_order_relaxed); index = (index + 1U) & (table.Capacity - 1U))
+					if (table.Slots[index].Hash.load(std::memory_order_relaxed) == hash && equal(slotType))
+					{
+						table.Slots[index].Type.store(type, std::memory_order_release);
+						return;
+					}
+
+				table.Slots[index].Hash.store(hash, std::memory_order_relaxed);
+				table.Slots[index].Type.store(type, std::memory_order_release);
+				++table.Size;
+			}
+
+			template <typename Match>
+			static TypeDescriptor *FindSlot(const std::atomic<Table*> &tablePtr, std::uint64_t hash, Match match)
+			{
+				const Table *table = tablePtr.load(std::memory_order_acquire);
+
+				if (!table)
+					return nullptr;
+
+				for (std::size_t index = hash & (table->Capacity - 1U); TypeDescriptor *type = table->Slots[index].Type.load(std::memory_order_acquire); index = (index + 1U) & (table->Capacity - 1U))
+					if (table->Slots[index].Hash.load(std::memory_order_relaxed) == hash && match(type))
+						return type;
+
+				return nullptr;
+			}
+
+			std::atomic<Table*> mIds{ nullptr };
+			std::atomic<Table*> mNames{ nullptr };
+			std::vector<std::unique_ptr<Table>> mTables;  // current and outgrown tables
+		};
+
+		inline TypeRegistry &GetTypeRegistry()
 		{
-			static std::map<std::string, TypeDescriptor*> typeRegistry;
+			static TypeRegistry typeRegistry;
 
 			return typeRegistry;
 		}
@@ -166,45 +367,52 @@ namespace Reflect
 			return 0U;
 		}
 
-		// internal function template that returns a type descriptor by type
+		// initializes the type descriptor of a (raw) type
 		template <typename Type>
-		TypeDescriptor *Resolve()
+		TypeDescriptor *InitTypeDescriptor()
 		{
-			TypeDescriptor *&typeDescPtr = GetTypeDescriptorPtr<RawType<Type>>();
+			TypeDescriptor &typeDesc = GetTypeDescriptor<Type>();
+
+			typeDesc.mSize = GetTypeSize<Type>();
+			typeDesc.mId = GetTypeId<Type>();
+
+			typeDesc.mIsVoid = std::is_void_v<Type>;
+			typeDesc.mIsIntegral = std::is_integral_v<Type>;
+			typeDesc.mIsFloatingPoint = std::is_floating_point_v<Type>;
+			typeDesc.mIsArray = std::is_array_v<Type>;
+			typeDesc.mIsPointer = std::is_pointer_v<Type>;
+			typeDesc.mIsPointerToDataMember = std::is_member_object_pointer_v<Type>;
+			typeDesc.mIsPointerToMemberFunction = std::is_member_function_pointer_v<Type>;
+			typeDesc.mIsNullPointer = std::is_null_pointer_v<Type>;
+			//typeDesc.mIsLValueReference = std::is_lvalue_reference_v<Type>;
+			//typeDesc.mIsRValueReference = std::is_rvalue_reference_v<Type>;
+			typeDesc.mIsClass = std::is_class_v<std::remove_pointer_t<Type>>;
+			typeDesc.mIsUnion = std::is_union_v<Type>;
+			typeDesc.mIsEnum = std::is_enum_v<Type>;
+			typeDesc.mIsFunction = std::is_function_v<Type>;
+
+			return &typeDesc;
+		}
 
-			if (!typeDescPtr)  // create a type descriptor if not present
-			{
-				TypeDescriptor &typeDesc = GetTypeDescriptor<RawType<Type>>();			
-				typeDescPtr = &typeDesc;  
-
-				typeDesc.mSize = GetTypeSize<Type>();
-
-				typeDesc.mIsVoid = std::is_void_v<Type>;
-				typeDesc.mIsIntegral = std::is_integral_v<Type>;
-				typeDesc.mIsFloatingPoint = std::is_floating_point_v<Type>;
-				typeDesc.mIsArray = std::is_array_v<Type>;
-				typeDesc.mIsPointer = std::is_pointer_v<Type>;
-				typeDesc.mIsPointerToDataMember = std::is_member_object_pointer_v<Type>;
-				typeDesc.mIsPointerToMemberFunction = std::is_member_function_pointer_v<Type>;
-				typeDesc.mIsNullPointer = std::is_null_pointer_v<Type>;
-				//typeDesc.mIsLValueReference = std::is_lvalue_reference_v<Type>;
-				//typeDesc.mIsRValueReference = std::is_rvalue_reference_v<Type>;
-				typeDesc.mIsClass = std::is_class_v<std::remove_pointer_t<Type>>;
-				typeDesc.mIsUnion = std::is_union_v<Type>;
-				typeDesc.mIsEnum = std::is_enum_v<Type>;
-				typeDesc.mIsFunction = std::is_function_v<Type>;
-			}
+		template <typename Type>
+		TypeDescriptor *GetTypeDescriptorPtr()
+		{
+			static TypeDescriptor *const typeDescriptorPtr = InitTypeDescriptor<Type>();  // thread safe initialization, a single acquire load afterwards
 
-			return typeDescPtr;
+			return typeDescriptorPtr;
+		}
+
+		// internal function template that returns a type descriptor by type
+		template <typename Type>
+		TypeDescriptor *Resolve()
+		{
+			return GetTypeDescriptorPtr<RawType<Type>>();
 		}
 
 		// internal function template that returns a type descriptor by object
 		template <typename Type>
 		TypeDescriptor *Resolve(Type &&object)
 		{
-			if (!GetTypeDescriptorPtr<RawType<Type>>())
-				Resolve<Type>();
-
 			return GetTypeDescriptorPtr<RawType<Type>>();
 		}
 
@@ -7,6 +7,8 @@
 #include "Constructor.hpp"
 #include "Base.hpp"
 #include "Conversion.hpp"
+#include <algorithm>
+#include <functional>
 
 namespace Reflect
 {
@@ -16,7 +18,9 @@ namespace Reflect
 	{
 		Constructor *constructor = new ConstructorImpl<Type, Args...>();
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mConstructors.push_back(constructor);
+		InvalidateTables(this);
 	}
 
 	template <typename Type, typename... Args>
@@ -24,7 +28,9 @@ namespace Reflect
 	{
 		Constructor *constructor = new FreeFunConstructor<Type, Args...>(ctorFun);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mConstructors.push_back(constructor);
+		InvalidateTables(this);
 	}
 
 	template <typename B, typename T>
@@ -32,7 +38,9 @@ namespace Reflect
 	{
 		Base *base = new BaseImpl<B, T>;
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mBases.push_back(base);
+		InvalidateTables(this, true);
 	}
 
 	template <typename C, typename T>
@@ -40,7 +48,9 @@ namespace Reflect
 	{
 		DataMember *dataMember = new PtrDataMember<C, T>(dataMemPtr, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mDataMembers.push_back(dataMember);
+		InvalidateTables(this);
 	}
 
 	template <auto Setter, auto Getter, typename Type>
@@ -48,7 +58,9 @@ namespace Reflect
 	{
 		DataMember *dataMember = new SetGetDataMember<Setter, Getter, Type>(name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mDataMembers.push_back(dataMember);
+		InvalidateTables(this);
 	}
 
 	template <typename Ret, typename... Args>
@@ -56,7 +68,9 @@ namespace Reflect
 	{
 		Function *memberFunction = new FreeFunction<Ret, Args...>(freeFun, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
 	}
 
 	template <typename C, typename Ret, typename... Args>
@@ -64,7 +78,9 @@ namespace Reflect
 	{
 		Function *memberFunction = new MemberFunction<C, Ret, Args...>(memFun, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
 	}
 
 	template <typename C, typename Ret, typename... Args>
@@ -72,7 +88,9 @@ namespace Reflect
 	{
 		Function *memberFunction = new ConstMemberFunction<C, Ret, Args...>(memFun, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
 	}
 
 	template <typename From, typename To>
@@ -80,28 +98,38 @@ namespace Reflect
 	{
 		Conversion *conversion = new ConversionImpl<From, To>;
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 		mConversions.push_back(conversion);
+		InvalidateTables(this, true);
 	}
 
 	inline std::string const &TypeDescriptor::GetName() const
-	{ 
-		return mName; 
+	{
+		static const std::string unnamed;  // resolved but not registered
+		const std::string *name = mName.load(std::memory_order_acquire);
+
+		return name ? *name : unnamed;
 	}
 
-	//inline std::size_t TypeDescriptor::GetSize() const
-	//{ 
-	//	return mSize; 
-	//}
+	inline TypeId TypeDescriptor::GetId() const
+	{
+		return mId;
+	}
+
+	inline std::size_t TypeDescriptor::GetSize() const
+	{ 
+		return mSize; 
+	}
 
-	inline std::vector<Constructor*> TypeDescriptor::GetConstructors() const
+	inline Span<Constructor* const> TypeDescriptor::GetConstructors() const
 	{ 
-		return mConstructors; 
+		return GetTables().Constructors; 
 	}
 
 	template <typename... Args>
 	const Constructor *TypeDescriptor::GetConstructor() const
 	{
-		for (auto *constructor : mConstructors)
+		for (auto *constructor : GetTables().Constructors)
 			if (constructor->CanConstruct<Args...>(std::index_sequence_for<Args...>()))
 				//if (constructor->CanConstruct<Args...>(std::make_index_sequence<sizeof...(Args)>()))
 				return constructor;
@@ -109,78 +137,189 @@ namespace Reflect
 		return nullptr;
 	}
 
-	inline std::vector<Base*> TypeDescriptor::GetBases() const
+	inline Span<Base* const> TypeDescriptor::GetBases() const
 	{ 
-		return mBases; 
+		return GetTables().Bases; 
 	}
 
 	template <typename B>
 	Base *TypeDescriptor::GetBase() const
 	{
-		for (auto base : mBases)
-			if (base->GetType() == Details::Resolve<B>)
+		for (auto base : GetTables().Bases)
+			if (base->GetType() == Details::Resolve<B>())
 				return base;
 
 		return nullptr;
 	}
 
-	inline std::vector<DataMember*> TypeDescriptor::GetDataMembers() const
+	inline bool TypeDescriptor::HasBase(const TypeDescriptor *base) const
 	{
-		std::vector<DataMember*> dataMembers(mDataMembers);
+		return FindBaseCast(base) != nullptr;
+	}
 
-		for (auto *base : mBases)
-			for (auto dataMember : base->GetType()->GetDataMembers())
-				dataMembers.push_back(dataMember);
+	inline void *TypeDescriptor::Cast(void *object, const TypeDescriptor *to) const
+	{
+		if (to == this)
+			return object;
+
+		const Details::BaseCast *baseCast = FindBaseCast(to);
+
+		if (!baseCast)
+			return nullptr;
+
+		if (!baseCast->Step)
+			return static_cast<char*>(object) + baseCast->Offset;
 
-		return dataMembers;
+		return baseCast->Step->Cast(Cast(object, baseCast->From));  // base reached through a virtual base
 	}
 
-	inline DataMember *TypeDescriptor::GetDataMember(const std::string &name) const
+	inline const Details::TypeTables &TypeDescriptor::GetTables() const
 	{
-		for (auto *dataMember : mDataMembers)
-			if (dataMember->GetName() == name)
-				return dataMember;
+		if (const Details::TypeTables *tables = mTables.load(std::memory_order_acquire))  // lock free once the tables are built
+			return *tables;
+
+		return BuildTables();
+	}
+
+	inline const Details::TypeTables &TypeDescriptor::BuildTables() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+		if (const Details::TypeTables *tables = mTables.load(std::memory_order_relaxed))  // built by another thread
+			return *tables;
+
+		auto tables = std::make_unique<Details::TypeTables>();
+
+		tables->Bases = mBases;
+		tables->Conversions = mConversions;
+		tables->Constructors = mConstructors;
+
+		CollectBases(tables->BaseCasts, this, 0, true);
+		std::sort(tables->BaseCasts.begin(), tables->BaseCasts.end(), [](const Details::BaseCast &a, const Details::BaseCast &b) { return std::less<const TypeDescriptor*>()(a.Type, b.Type); });
+
+		// own meta objects first, then those of each base
+		tables->DataMembers = mDataMembers;
+		tables->MemberFunctions = mMemberFunctions;
 
 		for (auto *base : mBases)
-			if (auto *baseDataMember = base->GetType()->GetDataMember(name))
-				return baseDataMember;
+		{
+			for (auto *dataMember : base->GetType()->GetDataMembers())
+				tables->DataMembers.push_back(dataMember);
 
-		return nullptr;
+			for (auto *memberFunction : base->GetType()->GetMemberFunctions())
+				tables->MemberFunctions.push_back(memberFunction);
+		}
+
+		// own meta objects hide inherited ones with the same name
+		tables->DataMemberIndex.Build(tables->DataMembers);
+		tables->MemberFunctionIndex.Build(tables->MemberFunctions);
+
+		if (!mHasTables)
+		{
+			Details::GetTypesWithTables().push_back(this);
+			mHasTables = true;
+		}
+
+		const Details::TypeTables *published = tables.get();
+		Details::GetTypeTablesStorage().push_back(std::move(tables));
+		mTables.store(published, std::memory_order_release);
+
+		return *published;
 	}
 
-	inline std::vector<Function*> TypeDescriptor::GetMemberFunctions() const
+	inline void TypeDescriptor::InvalidateTables(const TypeDescriptor *changed, bool areCastsChanged)
 	{
-		std::vector<Function*> memberFunctions(mMemberFunctions);
+		// the tables of a type include meta objects inherited from its bases (registration mutex must be held)
+		for (auto *type : Details::GetTypesWithTables())
+			if (const Details::TypeTables *tables = type->mTables.load(std::memory_order_relaxed); tables && (type == changed || FindBaseCast(*tables, changed)))
+				type->mTables.store(nullptr, std::memory_order_release);
 
-		for (auto *base : mBases)
-			for (auto memberFunction : base->GetType()->GetMemberFunctions())
-				memberFunctions.push_back(memberFunction);
+		if (areCastsChanged)  // drops the failed conversion plans cached by functions and constructors
+			Details::GetCastsGeneration().fetch_add(1, std::memory_order_release);
+	}
 
-		return memberFunctions;
+	inline void TypeDescriptor::CollectBases(std::vector<Details::BaseCast> &baseCasts, const TypeDescriptor *derived, std::ptrdiff_t offset, bool isFixedOffset) const
+	{
+		for (auto *base : derived->mBases)
+		{
+			bool isBaseFixedOffset = isFixedOffset && !base->IsVirtual();
+			std::ptrdiff_t baseOffset = offset + base->GetOffset();
+
+			// the first path found to a base is used (i.e. for virtual bases shared in a diamond)
+			if (std::find_if(baseCasts.begin(), baseCasts.end(), [base](const Details::BaseCast &baseCast) { return baseCast.Type == base->GetType(); }) != baseCasts.end())
+				continue;
+
+			if (isBaseFixedOffset)
+				baseCasts.push_back({ base->GetType(), baseOffset, nullptr, nullptr });
+			else
+				baseCasts.push_back({ base->GetType(), 0, base, derived });
+
+			CollectBases(baseCasts, base->GetType(), baseOffset, isBaseFixedOffset);
+		}
 	}
 
-	inline const Function *TypeDescriptor::GetMemberFunction(const std::string &name) const
+	inline const Details::BaseCast *TypeDescriptor::FindBaseCast(const TypeDescriptor *base) const
 	{
-		for (auto *memberFunction : mMemberFunctions)
-			if (memberFunction->GetName() == name)
-				return memberFunction;
+		return FindBaseCast(GetTables(), base);
+	}
 
-		for (auto *base : mBases)
-			if (auto *memberFunction = base->GetType()->GetMemberFunction(name))
-				return memberFunction;
+	inline const Details::BaseCast *TypeDescriptor::FindBaseCast(const Details::TypeTables &tables, const TypeDescriptor *base)
+	{
+		const std::vector<Details::BaseCast> &baseCasts = tables.BaseCasts;
 
-		return nullptr;
+		if (baseCasts.size() <= 8)  // linear search is faster for small hierarchies
+		{
+			for (auto &baseCast : baseCasts)
+				if (baseCast.Type == base)
+					return &baseCast;
+
+			return nullptr;
+		}
+
+		auto it = std::lower_bound(baseCasts.begin(), baseCasts.end(), base, [](const Details::BaseCast &baseCast, const TypeDescriptor *type) { return std::less<const TypeDescriptor*>()(baseCast.Type, type); });
+
+		return it != baseCasts.end() && it->Type == base ? &*it : nullptr;
+	}
+
+	inline Span<DataMember* const> TypeDescriptor::GetDataMembers() const
+	{
+		return GetTables().DataMembers;
+	}
+
+	inline DataMember *TypeDescriptor::GetDataMember(std::string_view name) const
+	{
+		return GetDataMember(HashedName(name));
+	}
+
+	inline DataMember *TypeDescriptor::GetDataMember(const HashedName &name) const
+	{
+		return GetTables().DataMemberIndex.Find(name);
+	}
+
+	inline Span<Function* const> TypeDescriptor::GetMemberFunctions() const
+	{
+		return GetTables().MemberFunctions;
+	}
+
+	inline const Function *TypeDescriptor::GetMemberFunction(std::string_view name) const
+	{
+		return GetMemberFunction(HashedName(name));
+	}
+
+	inline const Function *TypeDescriptor::GetMemberFunction(const HashedName &name) const
+	{
+		return GetTables().MemberFunctionIndex.Find(name);
 	}
 
-	inline std::vector<Conversion*> TypeDescriptor::GetConversions() const
+	inline Span<Conversion* const> TypeDescriptor::GetConversions() const
 	{ 
-		return mConversions; 
+		return GetTables().Conversions; 
 	}
 
 	template <typename To>
 	Conversion *TypeDescriptor::GetConversion() const
 	{
-		for (auto conversion : mConversions)
+		for (auto conversion : GetTables().Conversions)
 			if (conversion->GetToType() == Details::Resolve<To>())
 				return conversion;
 
@@ -3,6 +3,7 @@
 
 #include <string>
 #include "TypeDescriptor.hpp"
+#include "Fields.hpp"
 
 namespace Reflect
 {
@@ -23,8 +24,15 @@ namespace Reflect
 		{
 			TypeDescriptor *typeDescriptor = Details::Resolve<Type>();
 
-			typeDescriptor->mName = name;                           // #TODO_already_present
-			Details::GetTypeRegistry()[name] = typeDescriptor;
+			std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+			// the name is set by the first registration only: other threads may be reading it
+			if (!typeDescriptor->mName.load(std::memory_order_relaxed))
+			{
+				typeDescriptor->mNameStorage = name;
+				typeDescriptor->mName.store(&typeDescriptor->mNameStorage, std::memory_order_release);
+				Details::GetTypeRegistry().Insert(typeDescriptor);
+			}
 
 			return *this;
 		}
@@ -63,6 +71,14 @@ namespace Reflect
 			return *this;
 		}
 
+		// registers the compile time field list of the type (see FieldList) as data members
+		TypeFactory &AddFields()
+		{
+			std::apply([this](const auto&... fields) { (AddDataMember(fields.Ptr, fields.Name), ...); }, FieldList<Type>::Fields);
+
+			return *this;
+		}
+
 		template <auto Setter, auto Getter>
 		TypeFactory &AddDataMember(const std::string &name)
 		{
@@ -1,913 +1,4199 @@
+// generated by tools/amalgamate.py from the headers in reflect/, don't edit
+#ifndef REFLECT_SINGLE_INCLUDE_H
+#define REFLECT_SINGLE_INCLUDE_H
+
 #ifndef REFLECT_H
 #define REFLECT_H
 
+#ifndef TYPE_FACTORY_H
+#define TYPE_FACTORY_H
+
+#include <string>
+#ifndef TYPE_DESCRIPTOR_H
+#define TYPE_DESCRIPTOR_H
+
 #include <string>
 #include <vector>
-#include <map>
 #include <type_traits>
-#include <tuple>
-#include "meta_any.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <vector>
+#include <type_traits>
 
 namespace Reflect
 {
 
-	class TypeDescriptor;
+	/*
+	* Span is a non owning view over a contiguous sequence of objects (like C++20 std::span),
+	* it is returned by type descriptors to access meta objects without copying them
+	*/
+	template <typename T>
+	class Span
+	{
+	public:
+		Span() : mData(nullptr), mSize(0U) {}
+
+		Span(T *data, std::size_t size) : mData(data), mSize(size) {}
+
+		template <std::size_t N>
+		Span(T (&array)[N]) : mData(array), mSize(N) {}
+
+		template <typename Container, typename = std::enable_if_t<std::is_convertible_v<decltype(std::declval<Container&>().data()), T*>>>
+		Span(Container &container) : mData(container.data()), mSize(container.size()) {}
+
+		T *begin() const { return mData; }
+		T *end() const { return mData + mSize; }
+
+		T *data() const { return mData; }
+		std::size_t size() const { return mSize; }
+		bool empty() const { return mSize == 0U; }
+
+		T &operator[](std::size_t index) const { return mData[index]; }
+
+		Span subspan(std::size_t offset, std::size_t count) const { return Span(mData + offset, count); }
+
+		// copy the elements into a vector
+		operator std::vector<std::remove_const_t<T>>() const { return std::vector<std::remove_const_t<T>>(begin(), end()); }
+
+	private:
+		T *mData;
+		std::size_t mSize;
+	};
+
+}  // namespace Reflect
+
+#endif  // SPAN_H
+#ifndef HASH_H
+#define HASH_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace Reflect
+{
+
+	// FNV-1a hash of a name, usable at compile time
+	constexpr std::uint64_t HashName(std::string_view name)
+	{
+		std::uint64_t hash = 14695981039346656037ULL;
+
+		for (char c : name)
+		{
+			hash ^= static_cast<unsigned char>(c);
+			hash *= 1099511628211ULL;
+		}
+
+		return hash;
+	}
+
+	/*
+	* a name together with its hash, lookups by HashedName don't hash the name:
+	* static constexpr HashedName position("position") hashes it at compile time
+	*/
+	struct HashedName
+	{
+		constexpr explicit HashedName(std::string_view name) : Name(name), Hash(HashName(name)) {}
+
+		std::string_view Name;
+		std::uint64_t Hash;
+	};
+
+	/*
+	* identifier of a type, stable across runs of programs built with the same compiler: it can be
+	* stored or sent in place of the type name (Resolve(TypeId) returns the type descriptor)
+	*/
+	struct TypeId
+	{
+		std::uint64_t Value;
+
+		constexpr bool operator==(TypeId other) const { return Value == other.Value; }
+		constexpr bool operator!=(TypeId other) const { return Value != other.Value; }
+	};
 
 	namespace Details
 	{
-		
+
+		// the function signature contains the name of the type as spelled by the compiler
+		template <typename Type>
+		constexpr TypeId GetTypeId()
+		{
+#if defined(_MSC_VER)
+			return TypeId{ HashName(__FUNCSIG__) };
+#else
+			return TypeId{ HashName(__PRETTY_FUNCTION__) };
+#endif
+		}
+
+		/*
+		* open addressing hash table that indexes named meta objects (T must have a GetName member function),
+		* it's built once from the meta objects and used for lookups only
+		*/
 		template <typename T>
-		using RawType = typename std::remove_cv<typename std::remove_reference<typename std::remove_pointer<T>::type>::type>::type;
+		class NameIndex
+		{
+		public:
+			void Build(Span<T* const> objects)
+			{
+				mSlots.assign(GetCapacity(objects.size()), Slot{ 0U, nullptr });
+
+				for (auto *object : objects)  // if more objects have the same name the first one is found
+				{
+					std::uint64_t hash = HashName(object->GetName());
+
+					if (!Find(HashedName(object->GetName())))
+					{
+						std::size_t index = hash & (mSlots.size() - 1U);
+
+						while (mSlots[index].Object)
+							index = (index + 1U) & (mSlots.size() - 1U);
+
+						mSlots[index] = Slot{ hash, object };
+					}
+				}
+			}
+
+			T *Find(const HashedName &name) const
+			{
+				if (mSlots.empty())
+					return nullptr;
+
+				for (std::size_t index = name.Hash & (mSlots.size() - 1U); mSlots[index].Object; index = (index + 1U) & (mSlots.size() - 1U))
+					if (mSlots[index].Hash == name.Hash && mSlots[index].Object->GetName() == name.Name)
+						return mSlots[index].Object;
+
+				return nullptr;
+			}
+
+		private:
+			struct Slot
+			{
+				std::uint64_t Hash;
+				T *Object;  // nullptr if the slot is empty
+			};
+
+			// at most half the slots are used (capacity is a power of 2)
+			static std::size_t GetCapacity(std::size_t size)
+			{
+				if (size == 0U)
+					return 0U;
+
+				std::size_t capacity = 4U;
+
+				while (capacity < size * 2U)
+					capacity *= 2U;
+
+				return capacity;
+			}
+
+			std::vector<Slot> mSlots;
+		};
+
+	}  // namespace Details
+
+}  // namespace Reflect
+
+#endif  // HASH_H
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+* instrumentation of reflected calls is opt-in: build with -DREFLECT_INSTRUMENTATION (in all the translation units)
+* to count calls, latency, failed casts, conversions and Any heap allocations per meta object (function, constructor,
+* data member and conversion), without it the instrumentation macros compile to nothing and no stats are collected
+*/
+
+#ifdef REFLECT_INSTRUMENTATION
+	#include <atomic>
+	#include <chrono>
+	#include <memory>
+	#include <mutex>
+	#include <ostream>
+	#include <algorithm>
+#else
+	#include <iosfwd>
+#endif
+
+namespace Reflect
+{
+
+	// aggregated stats of a meta object
+	struct CallStats
+	{
+		static constexpr std::size_t HISTOGRAM_BUCKETS = 24;  // bucket i counts calls that took [2^i, 2^(i+1)) ns (the last one counts all the slower calls)
+
+		std::uint64_t Calls = 0;
+		std::uint64_t FailedCasts = 0;     // calls that failed because the object or an argument couldn't be cast or converted
+		std::uint64_t Conversions = 0;     // conversions performed during the calls (or calls of a conversion)
+		std::uint64_t HeapSpills = 0;      // objects that didn't fit an Any's SBO buffer during the calls
+		std::uint64_t Nanoseconds = 0;     // cumulative latency
+		std::uint64_t Histogram[HISTOGRAM_BUCKETS] = {};
+	};
+
+	struct MetaObjectStats
+	{
+		std::string TypeName;     // name of the type the meta object belongs to
+		std::string Kind;         // function, constructor, data member or conversion
+		std::string Description;  // name (or signature) of the meta object
+		CallStats Stats;
+	};
+
+#ifdef REFLECT_INSTRUMENTATION
+
+	namespace Details
+	{
+
+		using StatsId = std::size_t;
+
+		// counters of a meta object for a single thread: only the owning thread writes them, any thread can read them
+		struct MetaCounters
+		{
+			std::atomic<std::uint64_t> Calls{ 0 };
+			std::atomic<std::uint64_t> FailedCasts{ 0 };
+			std::atomic<std::uint64_t> Conversions{ 0 };
+			std::atomic<std::uint64_t> HeapSpills{ 0 };
+			std::atomic<std::uint64_t> Nanoseconds{ 0 };
+			std::atomic<std::uint64_t> Histogram[CallStats::HISTOGRAM_BUCKETS] = {};
+		};
+
+		// single writer: a relaxed load and store instead of an atomic read-modify-write
+		inline void AddCount(std::atomic<std::uint64_t> &counter, std::uint64_t count)
+		{
+			counter.store(counter.load(std::memory_order_relaxed) + count, std::memory_order_relaxed);
+		}
+
+		/*
+		* counters of all the meta objects for a single thread, allocated in chunks on first use
+		* (chunks are never moved, so that other threads can aggregate the counters while the owner updates them)
+		*/
+		class ThreadStats
+		{
+		public:
+			static constexpr std::size_t CHUNK_SIZE = 64;
+			static constexpr std::size_t MAX_CHUNKS = 1024;  // meta objects beyond CHUNK_SIZE * MAX_CHUNKS aren't tracked
+
+			~ThreadStats()
+			{
+				for (auto &chunk : mChunks)
+					delete[] chunk.load(std::memory_order_relaxed);
+			}
+
+			MetaCounters *Get(StatsId id)
+			{
+				if (id >= CHUNK_SIZE * MAX_CHUNKS)
+					return nullptr;
+
+				std::atomic<MetaCounters*> &chunk = mChunks[id / CHUNK_SIZE];
+				MetaCounters *counters = chunk.load(std::memory_order_relaxed);
+
+				if (!counters)
+				{
+					counters = new MetaCounters[CHUNK_SIZE];
+					chunk.store(counters, std::memory_order_release);
+				}
+
+				return counters + id % CHUNK_SIZE;
+			}
+
+			const MetaCounters *Find(StatsId id) const
+			{
+				if (id >= CHUNK_SIZE * MAX_CHUNKS)
+					return nullptr;
+
+				const MetaCounters *counters = mChunks[id / CHUNK_SIZE].load(std::memory_order_acquire);
+
+				return counters ? counters + id % CHUNK_SIZE : nullptr;
+			}
+
+			// running totals of the thread, a call is charged the difference between its start and its end
+			std::uint64_t Conversions = 0;
+			std::uint64_t HeapSpills = 0;
+
+		private:
+			std::atomic<MetaCounters*> mChunks[MAX_CHUNKS] = {};
+		};
+
+		class Instrumentation
+		{
+		public:
+			// fills the type name, kind and description of a meta object when the stats are collected
+			using Describe = void(*)(const void *metaObject, MetaObjectStats &stats);
+
+			StatsId Register(const void *metaObject, Describe describe)
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				mEntries.push_back({ metaObject, describe });
+
+				return mEntries.size() - 1;
+			}
+
+			ThreadStats &GetThreadStats()
+			{
+				thread_local ThreadStats *threadStats = nullptr;
+
+				if (!threadStats)  // the stats of a thread outlive it, so that its counts are still reported
+				{
+					std::lock_guard<std::mutex> lock(mMutex);
+
+					mThreads.push_back(std::make_unique<ThreadStats>());
+					threadStats = mThreads.back().get();
+				}
+
+				return *threadStats;
+			}
+
+			std::vector<MetaObjectStats> Collect()
+			{
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				std::vector<MetaObjectStats> collected;
+
+				for (StatsId id = 0; id < mEntries.size(); ++id)
+				{
+					MetaObjectStats stats;
+
+					for (auto &thread : mThreads)
+						if (const MetaCounters *counters = thread->Find(id))
+						{
+							stats.Stats.Calls += counters->Calls.load(std::memory_order_relaxed);
+							stats.Stats.FailedCasts += counters->FailedCasts.load(std::memory_order_relaxed);
+							stats.Stats.Conversions += counters->Conversions.load(std::memory_order_relaxed);
+							stats.Stats.HeapSpills += counters->HeapSpills.load(std::memory_order_relaxed);
+							stats.Stats.Nanoseconds += counters->Nanoseconds.load(std::memory_order_relaxed);
+
+							for (std::size_t i = 0; i < CallStats::HISTOGRAM_BUCKETS; ++i)
+								stats.Stats.Histogram[i] += counters->Histogram[i].load(std::memory_order_relaxed);
+						}
+
+					if (stats.Stats.Calls == 0)
+						continue;
+
+					mEntries[id].DescribeMetaObject(mEntries[id].MetaObject, stats);
+					collected.push_back(std::move(stats));
+				}
+
+				return collected;
+			}
+
+		private:
+			struct Entry
+			{
+				const void *MetaObject;
+				Describe DescribeMetaObject;
+			};
+
+			std::mutex mMutex;
+			std::vector<Entry> mEntries;  // indexed by stats id
+			std::vector<std::unique_ptr<ThreadStats>> mThreads;
+		};
+
+		inline Instrumentation &GetInstrumentation()
+		{
+			static Instrumentation instrumentation;
+
+			return instrumentation;
+		}
+
+		/*
+		* CallScope measures a call (or a batch of calls) of a meta object: latency,
+		* conversions and Any heap allocations made by the thread while the scope is alive
+		*/
+		class CallScope
+		{
+		public:
+			explicit CallScope(StatsId id)
+				: mId(id), mThreadStats(GetInstrumentation().GetThreadStats()), mConversions(mThreadStats.Conversions), mHeapSpills(mThreadStats.HeapSpills),
+				mStart(std::chrono::steady_clock::now()) {}
+
+			CallScope(const CallScope&) = delete;
+			CallScope &operator=(const CallScope&) = delete;
+
+			~CallScope()
+			{
+				std::uint64_t nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - mStart).count();
+
+				MetaCounters *counters = mThreadStats.Get(mId);
+
+				if (!counters)
+					return;
+
+				AddCount(counters->Calls, mCalls);
+				AddCount(counters->FailedCasts, mFailedCasts);
+				AddCount(counters->Conversions, mThreadStats.Conversions - mConversions);
+				AddCount(counters->HeapSpills, mThreadStats.HeapSpills - mHeapSpills);
+				AddCount(counters->Nanoseconds, nanoseconds);
+
+				std::uint64_t perCall = mCalls ? nanoseconds / mCalls : nanoseconds;
+				std::size_t bucket = 0;
+
+				while (perCall > 1 && bucket < CallStats::HISTOGRAM_BUCKETS - 1)
+				{
+					perCall >>= 1;
+					++bucket;
+				}
+
+				AddCount(counters->Histogram[bucket], mCalls);
+			}
+
+			void SetResult(bool isSuccess)
+			{
+				mFailedCasts = isSuccess ? 0 : 1;
+			}
+
+			void SetBatchResult(std::size_t calls, std::size_t successfulCalls)
+			{
+				mCalls = calls;
+				mFailedCasts = calls - successfulCalls;
+			}
+
+		private:
+			StatsId mId;
+			ThreadStats &mThreadStats;
+			std::uint64_t mConversions;
+			std::uint64_t mHeapSpills;
+			std::chrono::steady_clock::time_point mStart;
+			std::uint64_t mCalls = 1;
+			std::uint64_t mFailedCasts = 0;
+		};
+
+	}  // namespace Details
+
+	// stats of the meta objects called at least once, sorted by type name
+	inline std::vector<MetaObjectStats> CollectStats()
+	{
+		std::vector<MetaObjectStats> stats = Details::GetInstrumentation().Collect();
+
+		std::stable_sort(stats.begin(), stats.end(), [](const MetaObjectStats &a, const MetaObjectStats &b) { return a.TypeName < b.TypeName; });
+
+		return stats;
+	}
+
+	inline void DumpStats(std::ostream &os)
+	{
+		std::string typeName;
+		bool isFirst = true;
+
+		for (auto &metaObject : CollectStats())
+		{
+			if (isFirst || metaObject.TypeName != typeName)
+			{
+				typeName = metaObject.TypeName;
+				isFirst = false;
+
+				os << (typeName.empty() ? "(free functions)" : typeName) << '\n';
+			}
+
+			const CallStats &stats = metaObject.Stats;
+
+			os << "  " << metaObject.Kind << ' ' << metaObject.Description << ": " << stats.Calls << " calls, " << stats.FailedCasts << " failed casts, "
+				<< stats.Conversions << " conversions, " << stats.HeapSpills << " heap spills, " << stats.Nanoseconds / (stats.Calls ? stats.Calls : 1) << " ns/call\n";
+
+			os << "    latency (ns):";
+
+			for (std::size_t i = 0; i < CallStats::HISTOGRAM_BUCKETS; ++i)
+				if (stats.Histogram[i])
+					os << " [" << (std::uint64_t(1) << i) << ", " << (i + 1 < CallStats::HISTOGRAM_BUCKETS ? std::to_string(std::uint64_t(1) << (i + 1)) : std::string("inf")) << "): " << stats.Histogram[i];
+
+			os << '\n';
+		}
+	}
+
+	// the stats id of a meta object (a data member of its base class)
+	#define REFLECT_STATS_ID(describe) ::Reflect::Details::StatsId mStatsId = ::Reflect::Details::GetInstrumentation().Register(this, describe);
+
+	#define REFLECT_CALL_SCOPE(scope) ::Reflect::Details::CallScope scope(mStatsId)
+	#define REFLECT_CALL_RESULT(scope, isSuccess) scope.SetResult(isSuccess)
+	#define REFLECT_BATCH_RESULT(scope, calls, successfulCalls) scope.SetBatchResult(calls, successfulCalls)
+	#define REFLECT_COUNT_CONVERSION() ++::Reflect::Details::GetInstrumentation().GetThreadStats().Conversions
+	#define REFLECT_COUNT_HEAP_SPILL() ++::Reflect::Details::GetInstrumentation().GetThreadStats().HeapSpills
+
+#else
+
+	inline std::vector<MetaObjectStats> CollectStats()
+	{
+		return {};
+	}
+
+	inline void DumpStats(std::ostream&) {}
+
+	#define REFLECT_STATS_ID(describe)
+	#define REFLECT_CALL_SCOPE(scope) ((void)0)
+	#define REFLECT_CALL_RESULT(scope, isSuccess) ((void)0)
+	#define REFLECT_BATCH_RESULT(scope, calls, successfulCalls) ((void)0)
+	#define REFLECT_COUNT_CONVERSION() ((void)0)
+	#define REFLECT_COUNT_HEAP_SPILL() ((void)0)
+
+#endif  // REFLECT_INSTRUMENTATION
+
+}  // namespace Reflect
+
+#endif  // INSTRUMENTATION_H
+
+namespace Reflect
+{
+
+	// fwd declarations
+	class DataMember;
+	class Function;
+	class Constructor;
+	class Base;
+	class Conversion;
+	
+	template <typename>
+	class TypeFactory;
+
+	class TypeDescriptor;
+
+	// fwd declarations (for friend declarations inside TypeDescriptor)
+	namespace Details
+	{
 
 		template <typename Type>
-		TypeDescriptor &GetTypeDescriptor()
+		TypeDescriptor *Resolve();
+
+		template <typename Type>
+		TypeDescriptor *Resolve(Type &&);
+
+		template <typename Type>
+		TypeDescriptor *InitTypeDescriptor();
+
+		class ConversionPlanCache;
+
+		template <typename, bool>
+		class BatchArg;
+
+		// entry of the flattened table of all the direct and indirect bases of a type
+		struct BaseCast
 		{
-			static TypeDescriptor typeDescriptor;
+			const TypeDescriptor *Type;
+			std::ptrdiff_t Offset;      // pointer adjustment from the derived object (if Step is nullptr)
+			Base *Step;                 // base reached through a virtual base: cast applied to the From type
+			const TypeDescriptor *From;
+		};
+
+		/*
+		* the meta objects of a type as seen by readers: an immutable snapshot built on first use
+		* and rebuilt after new meta objects are registered for the type or one of its bases
+		*/
+		struct TypeTables
+		{
+			std::vector<Base*> Bases;
+			std::vector<Conversion*> Conversions;
+			std::vector<Constructor*> Constructors;
+			std::vector<DataMember*> DataMembers;    // own and inherited
+			std::vector<Function*> MemberFunctions;  // own and inherited
+			std::vector<BaseCast> BaseCasts;         // direct and indirect bases, sorted by type
+			NameIndex<DataMember> DataMemberIndex;
+			NameIndex<Function> MemberFunctionIndex;
+		};
+
+	}	// namespace Details
+
+	class TypeDescriptor
+	{
+		template <typename> friend class TypeFactory;
+
+		template <typename Type> friend TypeDescriptor *Details::InitTypeDescriptor();
+		friend class Details::ConversionPlanCache;
+		template <typename, bool> friend class Details::BatchArg;
+		friend class DataMember;
+
+	public:
+		template <typename Type, typename... Args>
+		void AddConstructor();
+
+		template <typename Type, typename... Args>
+		void AddConstructor(Type (*)(Args...));
+
+		template <typename B, typename T>
+		void AddBase();
+
+		template <typename C, typename T>
+		void AddDataMember(T C::*dataMemPtr, const std::string &name);
+
+		template <auto Setter, auto Getter, typename Type>
+		void AddDataMember(const std::string &name);
+
+		template <typename Ret, typename... Args>
+		void AddMemberFunction(Ret freeFun(Args...), const std::string &name);
+
+		template <typename C, typename Ret, typename... Args>
+		void AddMemberFunction(Ret(C::*memFun)(Args...), const std::string &name);
+
+		template <typename C, typename Ret, typename... Args>
+		void AddMemberFunction(Ret(C::*memFun)(Args...) const, const std::string &name);
+
+		template <typename From, typename To>
+		void AddConversion();
+
+		std::string const &GetName() const;
+
+		TypeId GetId() const;
+
+		std::size_t GetSize() const;
+
+		/*
+		* meta objects are accessed through non owning views: data members and member functions
+		* include those inherited from base classes. Types can be registered and resolved
+		* concurrently, registration is serialized and reads are lock free
+		*/
+
+		Span<Constructor* const> GetConstructors() const;
+
+		template <typename... Args>
+		const Constructor *GetConstructor() const;
+
+		Span<Base* const> GetBases() const;
+
+		template <typename B>
+		Base *GetBase() const;
+
+		bool HasBase(const TypeDescriptor *base) const;  // direct or indirect base
+
+		void *Cast(void *object, const TypeDescriptor *to) const;  // cast to the same type or to a direct or indirect base
+
+		Span<DataMember* const> GetDataMembers() const;
+
+		DataMember *GetDataMember(std::string_view name) const;
+
+		DataMember *GetDataMember(const HashedName &name) const;
+
+		Span<Function* const> GetMemberFunctions() const;
+
+		const Function *GetMemberFunction(std::string_view name) const;
+
+		const Function *GetMemberFunction(const HashedName &name) const;
+
+		Span<Conversion* const> GetConversions() const;
+
+		template <typename To>
+		Conversion *GetConversion() const;
+
+	private:
+		std::atomic<const std::string*> mName{ nullptr };  // points to mNameStorage once the type is registered, the name never changes afterwards
+		std::string mNameStorage;
+		std::size_t mSize;
+		TypeId mId;
+
+		std::vector<Base*> mBases;
+		std::vector<Conversion*> mConversions;
+		std::vector<Constructor*> mConstructors;
+		std::vector<DataMember*> mDataMembers;
+		std::vector<Function*> mMemberFunctions;
+
+		// tables published to readers, nullptr until first used or after being invalidated
+		mutable std::atomic<const Details::TypeTables*> mTables{ nullptr };
+		mutable bool mHasTables = false;  // (guarded by the registration mutex)
+
+		const Details::TypeTables &GetTables() const;
+		const Details::TypeTables &BuildTables() const;
+		void CollectBases(std::vector<Details::BaseCast> &baseCasts, const TypeDescriptor *derived, std::ptrdiff_t offset, bool isFixedOffset) const;
+		const Details::BaseCast *FindBaseCast(const TypeDescriptor *base) const;
+
+		static const Details::BaseCast *FindBaseCast(const Details::TypeTables &tables, const TypeDescriptor *base);
+		static void InvalidateTables(const TypeDescriptor *changed, bool areCastsChanged = false);
+
+		// C++ primary type categories
+		bool mIsVoid;
+		bool mIsIntegral;
+		bool mIsFloatingPoint;
+		bool mIsArray;
+		bool mIsPointer;
+		bool mIsPointerToDataMember;
+		bool mIsPointerToMemberFunction;
+		bool mIsNullPointer;
+		//bool mIsLValueReference;
+		//bool mIsRValueReference;
+		bool mIsClass;
+		bool mIsUnion;
+		bool mIsEnum;
+		bool mIsFunction;
+	};
+
+	namespace Details
+	{
+		/* 
+		* all cv and reference qualifiers are stripped, but pointers are distinct types
+		* (i.e. int and int* have two distint type descriptors)
+		*/
+		template <typename T>
+		using RawType = typename std::remove_cv<std::remove_reference_t<T>>::type;   
+
+		template <typename T>
+		TypeDescriptor &GetTypeDescriptor()
+		{
+			static TypeDescriptor typeDescriptor;  // single instance of type descriptor per reflected type
+
+			return typeDescriptor;
+		}
+
+		// serializes registration of types and meta objects (reads don't lock)
+		inline std::recursive_mutex &GetRegistrationMutex()
+		{
+			static std::recursive_mutex registrationMutex;
+
+			return registrationMutex;
+		}
+
+		// bumped when a base or a conversion is registered: argument types that couldn't be cast may be castable afterwards
+		inline std::atomic<std::uint64_t> &GetCastsGeneration()
+		{
+			static std::atomic<std::uint64_t> castsGeneration{ 0 };
+
+			return castsGeneration;
+		}
+
+		/*
+		* all the tables ever published: lock free readers and the views returned by the accessors of a type descriptor may still
+		* refer to replaced tables, so they are never freed. Tables are replaced only when a type or one of its bases is changed
+		* after its tables were built (by the first lookup): one snapshot is retained per such change and per type derived from
+		* the changed one, none if the types are registered before being looked up (guarded by the registration mutex)
+		*/
+		inline std::vector<std::unique_ptr<TypeTables>> &GetTypeTablesStorage()
+		{
+			static std::vector<std::unique_ptr<TypeTables>> typeTablesStorage;
+
+			return typeTablesStorage;
+		}
+
+		// type descriptors that have published tables (guarded by the registration mutex)
+		inline std::vector<const TypeDescriptor*> &GetTypesWithTables()
+		{
+			static std::vector<const TypeDescriptor*> typesWithTables;
+
+			return typesWithTables;
+		}
+
+		/*
+		* registry of the reflected types, indexed by type id and by name with open addressing
+		* hash tables: insertions are serialized by the registration mutex, lookups are lock free
+		* (slots are published with atomic stores, tables are never freed when they grow)
+		*/
+		class TypeRegistry
+		{
+		public:
+			void Insert(TypeDescriptor *typeDescriptor)
+			{
+				InsertSlot(mIds, typeDescriptor->GetId().Value, typeDescriptor, [typeDescriptor](const TypeDescriptor *type) { return type == typeDescriptor; });
+				InsertSlot(mNames, HashName(typeDescriptor->GetName()), typeDescriptor, [typeDescriptor](const TypeDescriptor *type) { return type->GetName() == typeDescriptor->GetName(); });
+			}
+
+			TypeDescriptor *Find(TypeId id) const
+			{
+				return FindSlot(mIds, id.Value, [id](const TypeDescriptor *type) { return type->GetId() == id; });
+			}
+
+			TypeDescriptor *Find(const HashedName &name) const
+			{
+				return FindSlot(mNames, name.Hash, [&name](const TypeDescriptor *type) { return type->GetName() == name.Name; });
+			}
+
+		private:
+			struct Slot
+			{
+				std::atomic<std::uint64_t> Hash;
+				std::atomic<TypeDescriptor*> Type;  // nullptr if the slot is empty
+			};
+
+			struct Table
+			{
+				explicit Table(std::size_t capacity) : Capacity(capacity), Size(0U), Slots(new Slot[capacity]()) {}
+
+				std::size_t Capacity;  // power of 2
+				std::size_t Size;
+				std::unique_ptr<Slot[]> Slots;
+			};
+
+			// a slot equal to an existing one is replaced
+			template <typename Equal>
+			void InsertSlot(std::atomic<Table*> &tablePtr, std::uint64_t hash, TypeDescriptor *type, Equal equal)
+			{
+				Table *table = tablePtr.load(std::memory_order_relaxed);
+
+				if (!table || (table->Size + 1U) * 2U > table->Capacity)  // at most half the slots are used
+				{
+					mTables.push_back(std::make_unique<Table>(table ? table->Capacity * 2U : 16U));
+					Table *newTable = mTables.back().get();
+
+					if (table)
+						for (std::size_t index = 0U; index < table->Capacity; ++index)
+							if (TypeDescriptor *oldType = table->Slots[index].Type.load(std::memory_order_relaxed))
+								InsertSlot(*newTable, table->Slots[index].Hash.load(std::memory_order_relaxed), oldType, [](const TypeDescriptor*) { return false; });
+
+					tablePtr.store(newTable, std::memory_order_release);
+					table = newTable;
+				}
+
+				InsertSlot(*table, hash, type, equal);
+			}
+
+			template <typename Equal>
+			static void InsertSlot(Table &table, std::uint64_t hash, TypeDescriptor *type, Equal equal)
+			{
+				std::size_t index = hash & (table.Capacity - 1U);
+
+				for (; TypeDescriptor *slotType = table.Slots[index].Type.load(std::memory_order_relaxed); index = (index + 1U) & (table.Capacity - 1U))
+					if (table.Slots[index].Hash.load(std::memory_order_relaxed) == hash && equal(slotType))
+					{
+						table.Slots[index].Type.store(type, std::memory_order_release);
+						return;
+					}
+
+				table.Slots[index].Hash.store(hash, std::memory_order_relaxed);
+				table.Slots[index].Type.store(type, std::memory_order_release);
+				++table.Size;
+			}
+
+			template <typename Match>
+			static TypeDescriptor *FindSlot(const std::atomic<Table*> &tablePtr, std::uint64_t hash, Match match)
+			{
+				const Table *table = tablePtr.load(std::memory_order_acquire);
+
+				if (!table)
+					return nullptr;
+
+				for (std::size_t index = hash & (table->Capacity - 1U); TypeDescriptor *type = table->Slots[index].Type.load(std::memory_order_acquire); index = (index + 1U) & (table->Capacity - 1U))
+					if (table->Slots[index].Hash.load(std::memory_order_relaxed) == hash && match(type))
+						return type;
+
+				return nullptr;
+			}
+
+			std::atomic<Table*> mIds{ nullptr };
+			std::atomic<Table*> mNames{ nullptr };
+			std::vector<std::unique_ptr<Table>> mTables;  // current and outgrown tables
+		};
+
+		inline TypeRegistry &GetTypeRegistry()
+		{
+			static TypeRegistry typeRegistry;
+
+			return typeRegistry;
+		}
+
+		template <typename Type>
+		inline constexpr auto GetTypeSize() -> typename std::enable_if<!std::is_same<RawType<Type>, void>::value, std::size_t>::type
+		{
+			return sizeof(Type);
+		}
+
+		template <typename Type>
+		inline constexpr auto GetTypeSize() -> typename std::enable_if<std::is_same<RawType<Type>, void>::value, std::size_t>::type
+		{
+			return 0U;
+		}
+
+		// initializes the type descriptor of a (raw) type
+		template <typename Type>
+		TypeDescriptor *InitTypeDescriptor()
+		{
+			TypeDescriptor &typeDesc = GetTypeDescriptor<Type>();
+
+			typeDesc.mSize = GetTypeSize<Type>();
+			typeDesc.mId = GetTypeId<Type>();
+
+			typeDesc.mIsVoid = std::is_void_v<Type>;
+			typeDesc.mIsIntegral = std::is_integral_v<Type>;
+			typeDesc.mIsFloatingPoint = std::is_floating_point_v<Type>;
+			typeDesc.mIsArray = std::is_array_v<Type>;
+			typeDesc.mIsPointer = std::is_pointer_v<Type>;
+			typeDesc.mIsPointerToDataMember = std::is_member_object_pointer_v<Type>;
+			typeDesc.mIsPointerToMemberFunction = std::is_member_function_pointer_v<Type>;
+			typeDesc.mIsNullPointer = std::is_null_pointer_v<Type>;
+			//typeDesc.mIsLValueReference = std::is_lvalue_reference_v<Type>;
+			//typeDesc.mIsRValueReference = std::is_rvalue_reference_v<Type>;
+			typeDesc.mIsClass = std::is_class_v<std::remove_pointer_t<Type>>;
+			typeDesc.mIsUnion = std::is_union_v<Type>;
+			typeDesc.mIsEnum = std::is_enum_v<Type>;
+			typeDesc.mIsFunction = std::is_function_v<Type>;
+
+			return &typeDesc;
+		}
+
+		template <typename Type>
+		TypeDescriptor *GetTypeDescriptorPtr()
+		{
+			static TypeDescriptor *const typeDescriptorPtr = InitTypeDescriptor<Type>();  // thread safe initialization, a single acquire load afterwards
+
+			return typeDescriptorPtr;
+		}
+
+		// internal function template that returns a type descriptor by type
+		template <typename Type>
+		TypeDescriptor *Resolve()
+		{
+			return GetTypeDescriptorPtr<RawType<Type>>();
+		}
+
+		// internal function template that returns a type descriptor by object
+		template <typename Type>
+		TypeDescriptor *Resolve(Type &&object)
+		{
+			return GetTypeDescriptorPtr<RawType<Type>>();
+		}
+
+	}  // namespace Details
+
+}  // namespace Reflect
+
+#ifndef DATA_MEMBER_H
+#define DATA_MEMBER_H
+
+#ifndef META_ANY_H
+#define META_ANY_H
+
+#ifndef ANY_ALLOCATOR_H
+#define ANY_ALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <memory_resource>
+
+namespace Reflect
+{
+
+	/*
+	* allocators used by Any for objects that don't fit in the SBO buffer:
+	* they are stateless (Any doesn't store them), memory is requested with
+	* the size and alignment of the contained object
+	*/
+
+	// allocates objects with global (aligned) operator new/delete
+	class HeapAllocator
+	{
+	public:
+		static void *Allocate(std::size_t size, std::size_t alignment)
+		{
+			return ::operator new(size, std::align_val_t(alignment));
+		}
+
+		static void Deallocate(void *memory, std::size_t size, std::size_t alignment)
+		{
+			::operator delete(memory, size, std::align_val_t(alignment));
+		}
+	};
+
+	/*
+	* allocates objects from the memory resource currently set on the calling thread (i.e. a
+	* std::pmr::monotonic_buffer_resource reset each frame or a std::pmr::unsynchronized_pool_resource),
+	* the resource is recorded in front of each allocation so that the object can be released from
+	* any thread, after the thread's resource has changed: the resource must outlive the objects
+	*/
+	class MemoryResourceAllocator
+	{
+	public:
+		static void SetMemoryResource(std::pmr::memory_resource *resource)
+		{
+			GetResource() = resource ? resource : std::pmr::get_default_resource();
+		}
+
+		static std::pmr::memory_resource *GetMemoryResource()
+		{
+			return GetResource();
+		}
+
+		static void *Allocate(std::size_t size, std::size_t alignment)
+		{
+			std::pmr::memory_resource *resource = GetResource();
+			std::size_t headerSize = GetHeaderSize(alignment);
+
+			unsigned char *memory = static_cast<unsigned char*>(resource->allocate(headerSize + size, GetHeaderAlignment(alignment)));
+			new(memory + headerSize - sizeof(std::pmr::memory_resource*)) std::pmr::memory_resource*(resource);
+
+			return memory + headerSize;
+		}
+
+		static void Deallocate(void *memory, std::size_t size, std::size_t alignment)
+		{
+			std::size_t headerSize = GetHeaderSize(alignment);
+			unsigned char *block = static_cast<unsigned char*>(memory) - headerSize;
+			std::pmr::memory_resource *resource = *reinterpret_cast<std::pmr::memory_resource**>(block + headerSize - sizeof(std::pmr::memory_resource*));
+
+			resource->deallocate(block, headerSize + size, GetHeaderAlignment(alignment));
+		}
+
+	private:
+		static std::pmr::memory_resource *&GetResource()
+		{
+			thread_local std::pmr::memory_resource *resource = std::pmr::get_default_resource();  // one resource per thread
+
+			return resource;
+		}
+
+		static constexpr std::size_t GetHeaderAlignment(std::size_t alignment)
+		{
+			return alignment > alignof(std::pmr::memory_resource*) ? alignment : alignof(std::pmr::memory_resource*);
+		}
+
+		// the header keeps the object aligned and stores the resource pointer right before it
+		static constexpr std::size_t GetHeaderSize(std::size_t alignment)
+		{
+			return sizeof(std::pmr::memory_resource*) > alignment ? sizeof(std::pmr::memory_resource*) : alignment;
+		}
+	};
+
+}  // namespace Reflect
+
+#endif  // ANY_ALLOCATOR_H
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <string>
+#include <exception>
+
+namespace Reflect
+{
+
+	namespace Details
+	{
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t)>
+		struct AlignedStorage
+		{
+			static_assert(SIZE >= sizeof(void*), "storage must be at least the size of a pointer");
+
+			struct Type
+			{
+				alignas(ALIGNMENT) unsigned char Storage[SIZE];
+			};
+		};
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t)>
+		using AlignedStorageT = typename AlignedStorage<SIZE, ALIGNMENT>::Type;
+
+		/*
+		* table of type erased operations, a single static instance per type is shared by all the Any
+		* objects holding that type (whatever their SBO size): operations work on object addresses, 
+		* the Any decides whether the object lives in the SBO buffer or on the heap
+		*
+		* a null operation means the object can be copied with memcpy (Copy, Move)
+		* or its destructor does nothing (Destroy), i.e. for trivially copyable objects
+		*/
+		struct AnyOperations
+		{
+			void (*Copy)(void *to, const void *from);  // copy construct into uninitialized memory
+			void (*Move)(void *to, void *from);        // move construct into uninitialized memory and destroy source
+			void (*Destroy)(void *instance);
+			std::size_t Size;
+			std::size_t Alignment;
+			bool IsNothrowMovable;                     // objects whose move may throw are never stored in the SBO buffer
+		};
+
+		template <typename T>
+		struct AnyTypeTraits
+		{
+			static void Copy(void *to, const void *from)
+			{
+				new(to) T(*static_cast<const T*>(from));
+			}
+
+			static void Move(void *to, void *from)
+			{
+				T &instance = *static_cast<T*>(from);
+				new(to) T(std::move(instance));
+				instance.~T();
+			}
+
+			static void Destroy(void *instance)
+			{
+				static_cast<T*>(instance)->~T();
+			}
+
+			static constexpr AnyOperations Operations{ 
+				std::is_trivially_copyable_v<T> ? nullptr : &Copy,
+				std::is_trivially_copyable_v<T> ? nullptr : &Move,
+				std::is_trivially_destructible_v<T> ? nullptr : &Destroy,
+				sizeof(T), 
+				alignof(T),
+				std::is_nothrow_move_constructible_v<T>
+			};
+		};
+
+	}  // namespace Details
+
+	/*
+	* BadCastException stores the types involved in a failed cast, the message
+	* is only formatted when what() is called (throwing it doesn't allocate)
+	*/
+	class BadCastException : public std::exception
+	{
+	public:
+		BadCastException(const TypeDescriptor *retrieved, const TypeDescriptor *contained, const char *context = "")
+			: mRetrieved(retrieved), mContained(contained), mContext(context) {}
+
+		BadCastException(const std::string &retrieved, const std::string &contained, const std::string &msg = "")
+			: mRetrieved(nullptr), mContained(nullptr), mContext(""), mMessage(msg + " wrong type from Get: tried to get " + retrieved + ", contained " + contained) {}
+
+		const char *what() const noexcept override
+		{
+			if (mMessage.empty())
+			{
+				try
+				{
+					mMessage = std::string(mContext) + " wrong type from Get: tried to get " + GetTypeName(mRetrieved) + ", contained " + GetTypeName(mContained);
+				}
+				catch (...)
+				{
+					return "wrong type from Get";
+				}
+			}
+
+			return mMessage.c_str();
+		}
+
+		const TypeDescriptor *GetRetrievedType() const { return mRetrieved; }
+		const TypeDescriptor *GetContainedType() const { return mContained; }
+
+	private:
+		static std::string GetTypeName(const TypeDescriptor *type)
+		{
+			return type ? type->GetName() : std::string("nothing");
+		}
+
+		const TypeDescriptor *mRetrieved;
+		const TypeDescriptor *mContained;
+		const char *mContext;
+		mutable std::string mMessage;  // formatted on first call to what()
+	};
+
+	/*
+	* the SBO size, alignment and allocator of the Any used throughout the library can be chosen 
+	* at build time (i.e. -DREFLECT_ANY_SIZE=32), Any objects with different SBO size, alignment
+	* and allocator can be copied, moved and converted into each other
+	*/
+#ifndef REFLECT_ANY_SIZE
+	#define REFLECT_ANY_SIZE sizeof(void*)
+#endif
+
+#ifndef REFLECT_ANY_ALIGNMENT
+	#define REFLECT_ANY_ALIGNMENT alignof(std::max_align_t)
+#endif
+
+#ifndef REFLECT_ANY_ALLOCATOR
+	#define REFLECT_ANY_ALLOCATOR HeapAllocator
+#endif
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT = alignof(std::max_align_t), typename Allocator = HeapAllocator>
+	class BasicAny;
+
+	using Any = BasicAny<REFLECT_ANY_SIZE, REFLECT_ANY_ALIGNMENT, REFLECT_ANY_ALLOCATOR>;
+
+	namespace Details
+	{
+
+		template <typename T>
+		struct IsBasicAny : std::false_type {};
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		struct IsBasicAny<BasicAny<SIZE, ALIGNMENT, Allocator>> : std::true_type {};
+
+	}  // namespace Details
+
+	/*
+	* AnyRef is an object that contains a pointer to any other object
+	* but does not manage its lifetime; a view of a const object (or of a const Any)
+	* is const: it can only be cast to a const type
+	*/
+	class AnyRef
+	{
+		template <std::size_t, std::size_t, typename> friend class BasicAny;
+
+	public:
+		AnyRef() : mInstance(nullptr), mType(nullptr), mIsConst(false) {}
+
+		template <typename T, typename U = std::remove_cv_t<T>, typename = std::enable_if_t<!std::is_same_v<U, AnyRef> && !Details::IsBasicAny<U>::value>>
+		AnyRef(T &object) : mInstance(const_cast<U*>(&object)), mType(Details::Resolve<U>()), mIsConst(std::is_const_v<T>) {}
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		AnyRef(BasicAny<SIZE, ALIGNMENT, Allocator> &any) : mInstance(any.Get()), mType(any.GetType()), mIsConst(any.IsConstRef()) {}
+
+		template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+		AnyRef(const BasicAny<SIZE, ALIGNMENT, Allocator> &any) : mInstance(const_cast<void*>(any.Get())), mType(any.GetType()), mIsConst(true) {}
+
+		void *Get() const { return mInstance; }  // the object of a const view must not be modified through the returned pointer
+		const TypeDescriptor *GetType() const { return mType; }
+		bool IsConst() const { return mIsConst; }
+
+		// nullptr if the object isn't a T (or derived from T) or if T isn't const and the view is
+		template <typename T>
+		T *TryCast() const;
+
+	private:
+		void *mInstance;
+		TypeDescriptor const *mType;
+		bool mIsConst;
+	};
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void swap(BasicAny<SIZE, ALIGNMENT, Allocator> &any1, BasicAny<SIZE, ALIGNMENT, Allocator> &any2) noexcept
+	{
+		any1.Swap(any2);
+	}
+
+	/*
+	* Any acts as a container of an object of any kind, it either allocates the object dynamically 
+	* with Allocator or uses a SBO optimization for objects whose size is less than SIZE
+	* and whose alignment is less than ALIGNMENT
+	*/
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	class BasicAny
+	{
+		friend class AnyRef;
+
+		template <std::size_t, std::size_t, typename> friend class BasicAny;
+
+	public:
+		BasicAny();
+
+		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!Details::IsBasicAny<U>::value>::type>
+		BasicAny(T &&object);
+
+		BasicAny(const BasicAny &other);
+		BasicAny(BasicAny &&other) noexcept;
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		BasicAny(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		BasicAny(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &&other);
+
+		BasicAny(AnyRef handle);
+
+		template <typename T, typename... Args>
+		explicit BasicAny(std::in_place_type_t<T>, Args&&... args);
+
+		~BasicAny();
+
+		template <typename T, typename U = typename std::remove_cv<std::remove_reference_t<std::decay_t<T>>>::type, typename = typename std::enable_if<!Details::IsBasicAny<U>::value>::type>
+		BasicAny &operator=(T &&object);
+
+		BasicAny &operator=(const BasicAny &other);
+		BasicAny &operator=(BasicAny &&other) noexcept;
+
+		void Swap(BasicAny &other) noexcept;
+
+		// destroy the contained object (if any) and construct a new one in place
+		template <typename T, typename... Args>
+		std::decay_t<T> &Emplace(Args&&... args);
+
+		// replace the contained object (if any) by the result of fun, destroyed only after fun returns (fun may read it)
+		template <typename T, typename F>
+		std::decay_t<T> &EmplaceInvoke(F &&fun);
+
+		void Reset();
+
+		explicit operator bool() const { return Get() != nullptr; }
+
+		const TypeDescriptor *GetType() const;
+
+		const void *Get() const;
+		
+		void *Get();
+
+		template <typename T>
+		const T *TryCast() const;
+
+		template <typename T>
+		T *TryCast();
+
+		template <typename T>
+		BasicAny TryConvert() const;
+
+		bool IsRef() const { return mOperations == nullptr; }  // check if it's a AnyRef
+		bool IsConstRef() const { return IsRef() && (reinterpret_cast<std::uintptr_t>(mType) & CONST_REF_TAG); }  // a view of a const object
+
+	private:
+		Details::AlignedStorageT<SIZE, ALIGNMENT> mStorage;  // holds the object (SBO) or a pointer to it (heap allocated object or AnyRef)
+
+		const TypeDescriptor *mType;                // tagged with CONST_REF_TAG for a view of a const object
+		const Details::AnyOperations *mOperations;  // nullptr for empty Any and AnyRef
+
+		// type descriptors are at least pointer aligned, the lowest bit of mType marks a const view (keeps Any within 32 bytes)
+		static constexpr std::uintptr_t CONST_REF_TAG = 1U;
+
+		// objects in the SBO buffer are moved when the Any is moved: only those that can't throw are stored there (moving an Any never throws)
+		static constexpr bool IsInline(std::size_t size, std::size_t alignment, bool isNothrowMovable) { return size <= SIZE && alignment <= ALIGNMENT && isNothrowMovable; }
+		static bool IsInline(const Details::AnyOperations *operations) { return IsInline(operations->Size, operations->Alignment, operations->IsNothrowMovable); }
+
+		template <typename T>
+		static constexpr bool IsInline() { return IsInline(sizeof(T), alignof(T), std::is_nothrow_move_constructible_v<T>); }
+
+		template <typename T, typename Init>
+		void Construct(Init &&init);
+
+		void Destroy();
+
+		static void *Allocate(const Details::AnyOperations *operations);
+		static void Deallocate(void *instance, const Details::AnyOperations *operations);
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		void CopyFrom(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
+
+		template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+		void MoveFrom(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other);
+
+		void MoveStorage(void *to, void *from) const;
+	};
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny() : mType(nullptr), mOperations(nullptr)
+	{
+		new(&mStorage) void*(nullptr);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename U, typename>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(T &&object) : mType(nullptr), mOperations(nullptr)
+	{
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<T>(object)); });
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename... Args>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(std::in_place_type_t<T>, Args&&... args) : mType(nullptr), mOperations(nullptr)
+	{
+		using U = std::decay_t<T>;
+
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<Args>(args)...); });
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(const BasicAny &other) : mType(other.mType), mOperations(other.mOperations)
+	{
+		CopyFrom(other);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(BasicAny &&other) noexcept : mType(other.mType), mOperations(other.mOperations)
+	{
+		MoveFrom(other);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other) : mType(other.mType), mOperations(other.mOperations)
+	{
+		CopyFrom(other);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &&other) : mType(other.mType), mOperations(other.mOperations)
+	{
+		MoveFrom(other);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::BasicAny(AnyRef handle)
+		: mType(reinterpret_cast<const TypeDescriptor*>(reinterpret_cast<std::uintptr_t>(handle.mType) | (handle.mIsConst ? CONST_REF_TAG : 0U))), mOperations(nullptr)
+	{
+		new(&mStorage) void*(handle.mInstance);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator>::~BasicAny()
+	{
+		Destroy();
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename U, typename>
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(T &&object)
+	{
+		BasicAny temp(std::forward<T>(object));
+		Swap(temp);
+
+		return *this;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(const BasicAny &other)
+	{
+		//Any temp(other);
+		//Swap(temp);
+
+		//return *this;
+
+		return *this = BasicAny(other);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	BasicAny<SIZE, ALIGNMENT, Allocator> &BasicAny<SIZE, ALIGNMENT, Allocator>::operator=(BasicAny &&other) noexcept
+	{
+		BasicAny temp(std::move(other));
+		Swap(temp);
+
+		return *this;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Swap(BasicAny &other) noexcept
+	{
+		if (this == &other)
+			return;
+
+		Details::AlignedStorageT<SIZE, ALIGNMENT> temp;
+		MoveStorage(&temp, &mStorage);
+		other.MoveStorage(&mStorage, &other.mStorage);
+		MoveStorage(&other.mStorage, &temp);
+
+		std::swap(mType, other.mType);
+		std::swap(mOperations, other.mOperations);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename... Args>
+	std::decay_t<T> &BasicAny<SIZE, ALIGNMENT, Allocator>::Emplace(Args&&... args)
+	{
+		using U = std::decay_t<T>;
+
+		Reset();
+		Construct<U>([&](void *instance) { new(instance) U(std::forward<Args>(args)...); });
+
+		return *static_cast<U*>(Get());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename F>
+	std::decay_t<T> &BasicAny<SIZE, ALIGNMENT, Allocator>::EmplaceInvoke(F &&fun)
+	{
+		using U = std::decay_t<T>;
+
+		// fun may read the contained object (i.e. a call whose argument is this Any), it's destroyed only after fun returns
+		if (!mOperations)
+		{
+			Reset();  // empty or AnyRef: nothing owned to destroy
+			Construct<U>([&](void *instance) { new(instance) U(std::forward<F>(fun)()); });  // guaranteed copy elision
+		}
+		else if constexpr (!IsInline<U>())
+		{
+			const Details::AnyOperations *operations = &Details::AnyTypeTraits<U>::Operations;
+			void *instance = Allocate(operations);
+
+			try
+			{
+				new(instance) U(std::forward<F>(fun)());  // constructed in its new storage, next to the contained object
+			}
+			catch (...)
+			{
+				Deallocate(instance, operations);
+				throw;
+			}
+
+			Destroy();
+
+			new(&mStorage) void*(instance);
+			mType = Details::Resolve<U>();
+			mOperations = operations;
+		}
+		else
+		{
+			U result(std::forward<F>(fun)());  // the storage is shared with the contained object: compute the result first
+
+			Reset();
+			Construct<U>([&](void *instance) { new(instance) U(std::move(result)); });  // inline objects can be moved
+		}
+
+		return *static_cast<U*>(Get());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Reset()
+	{
+		Destroy();
+
+		new(&mStorage) void*(nullptr);
+		mType = nullptr;
+		mOperations = nullptr;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T, typename Init>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Construct(Init &&init)
+	{
+		// the Any must be empty, type and operations are set after the object is constructed, so that it's still empty if construction throws
+		const Details::AnyOperations *operations = &Details::AnyTypeTraits<T>::Operations;
+
+		if constexpr (IsInline<T>())
+		{
+			try
+			{
+				init(static_cast<void*>(&mStorage));
+			}
+			catch (...)
+			{
+				new(&mStorage) void*(nullptr);
+				throw;
+			}
+		}
+		else
+		{
+			void *instance = Allocate(operations);
+
+			try
+			{
+				init(instance);
+			}
+			catch (...)
+			{
+				Deallocate(instance, operations);
+				throw;
+			}
+
+			new(&mStorage) void*(instance);
+		}
+
+		mType = Details::Resolve<T>();
+		mOperations = operations;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Destroy()
+	{
+		if (!mOperations)
+			return;
+
+		void *instance = Get();
+
+		if (mOperations->Destroy)
+			mOperations->Destroy(instance);
+
+		if (!IsInline(mOperations))
+			Deallocate(instance, mOperations);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void *BasicAny<SIZE, ALIGNMENT, Allocator>::Allocate(const Details::AnyOperations *operations)
+	{
+		REFLECT_COUNT_HEAP_SPILL();
+
+		return Allocator::Allocate(operations->Size, operations->Alignment);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::Deallocate(void *instance, const Details::AnyOperations *operations)
+	{
+		Allocator::Deallocate(instance, operations->Size, operations->Alignment);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::CopyFrom(const BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other)
+	{
+		if (!mOperations)  // empty Any or AnyRef: copy the pointer
+		{
+			new(&mStorage) void*(const_cast<void*>(other.Get()));
+			return;
+		}
+
+		void *instance = &mStorage;
+
+		if (!IsInline(mOperations))
+			instance = Allocate(mOperations);
+
+		if (!mOperations->Copy)  // trivially copyable object: copy the bytes
+			std::memcpy(instance, other.Get(), mOperations->Size);
+		else
+		{
+			try
+			{
+				mOperations->Copy(instance, other.Get());
+			}
+			catch (...)
+			{
+				if (instance != &mStorage)
+					Deallocate(instance, mOperations);
+				throw;
+			}
+		}
+
+		if (instance != &mStorage)
+			new(&mStorage) void*(instance);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <std::size_t OTHER_SIZE, std::size_t OTHER_ALIGNMENT, typename OtherAllocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::MoveFrom(BasicAny<OTHER_SIZE, OTHER_ALIGNMENT, OtherAllocator> &other)
+	{
+		if (!mOperations)  // empty Any or AnyRef: copy the pointer
+		{
+			new(&mStorage) void*(other.Get());
+			return;
+		}
+
+		if constexpr (OTHER_SIZE == SIZE && OTHER_ALIGNMENT == ALIGNMENT && std::is_same_v<OtherAllocator, Allocator>)
+			other.MoveStorage(&mStorage, &other.mStorage);
+		else
+		{
+			bool otherIsInline = other.IsInline(mOperations);
+			void *otherInstance = other.Get();
+
+			if (!otherIsInline && !IsInline(mOperations) && std::is_same_v<OtherAllocator, Allocator>)  // steal the heap allocated object
+				new(&mStorage) void*(otherInstance);
+			else
+			{
+				void *instance = IsInline(mOperations) ? static_cast<void*>(&mStorage) : Allocate(mOperations);
+
+				if (!mOperations->Move)  // trivially copyable object: copy the bytes
+					std::memcpy(instance, otherInstance, mOperations->Size);
+				else
+					mOperations->Move(instance, otherInstance);
+
+				if (!otherIsInline)
+					other.Deallocate(otherInstance, mOperations);
+
+				if (instance != &mStorage)
+					new(&mStorage) void*(instance);
+			}
+		}
+
+		// moved from Any is left empty
+		new(&other.mStorage) void*(nullptr);
+		other.mType = nullptr;
+		other.mOperations = nullptr;
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void BasicAny<SIZE, ALIGNMENT, Allocator>::MoveStorage(void *to, void *from) const
+	{
+		// empty Any, AnyRef, heap allocated or trivially copyable object: copy the bytes
+		if (!mOperations || !mOperations->Move || !IsInline(mOperations))
+			std::memcpy(to, from, sizeof(Details::AlignedStorageT<SIZE, ALIGNMENT>));
+		else
+			mOperations->Move(to, from);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	const TypeDescriptor *BasicAny<SIZE, ALIGNMENT, Allocator>::GetType() const
+	{
+		return reinterpret_cast<const TypeDescriptor*>(reinterpret_cast<std::uintptr_t>(mType) & ~CONST_REF_TAG);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	const void *BasicAny<SIZE, ALIGNMENT, Allocator>::Get() const
+	{
+		if (mOperations && IsInline(mOperations))
+			return &mStorage;
+
+		return *reinterpret_cast<void* const*>(&mStorage);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	void *BasicAny<SIZE, ALIGNMENT, Allocator>::Get()
+	{
+		return const_cast<void*>(static_cast<const BasicAny&>(*this).Get());
+		//return const_cast<void*>(std::as_const(*this).Get());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T>
+	const T *BasicAny<SIZE, ALIGNMENT, Allocator>::TryCast() const
+	{
+		const TypeDescriptor *typeDesc = Details::Resolve<T>();
+		
+		void *casted = nullptr;
+		void *instance = const_cast<void*>(Get());
+
+		if (!instance)
+			return static_cast<T const*>(casted);
+
+		if (typeDesc == GetType())
+			casted = instance;
+		else
+			casted = GetType()->Cast(instance, typeDesc);  // direct and indirect bases
+
+		return static_cast<T const*>(casted);
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T>
+	T *BasicAny<SIZE, ALIGNMENT, Allocator>::TryCast()
+	{
+		if (!std::is_const_v<T> && IsConstRef())  // a view of a const object can only be cast to a const type
+			return nullptr;
+
+		return const_cast<T*>(static_cast<const BasicAny&>(*this).TryCast<T>());
+		//return const_cast<T*>(std::as_const(*this).TryCast<T>());
+	}
+
+	template <std::size_t SIZE, std::size_t ALIGNMENT, typename Allocator>
+	template <typename T>
+	BasicAny<SIZE, ALIGNMENT, Allocator> BasicAny<SIZE, ALIGNMENT, Allocator>::TryConvert() const
+	{
+		BasicAny converted;
+
+		if (!*this)
+			return converted;
+
+		if (TypeDescriptor const *typeDesc = Details::Resolve<T>(); typeDesc == GetType())
+			converted = *this;
+		else
+		{
+			for (auto *conversion : GetType()->GetConversions())
+				if (conversion->GetToType() == typeDesc)
+					converted = conversion->Convert(Get());
+		}
+
+		return converted;
+	}
+
+	template <typename T>
+	T *AnyRef::TryCast() const
+	{
+		if ((!std::is_const_v<T> && mIsConst) || !mType)
+			return nullptr;
+
+		return static_cast<T*>(mType->Cast(mInstance, Details::Resolve<T>()));
+	}
+
+	namespace Details
+	{
+
+		/*
+		* returns a pointer to the argument if it's a T (or a type derived from T),
+		* otherwise converts it to a T in the converted argument's storage
+		*/
+		template <typename T>
+		T *CastOrConvert(AnyRef arg, Any &converted)
+		{
+			if (!arg.GetType())
+				return nullptr;
+
+			if (void *instance = arg.GetType()->Cast(arg.Get(), Resolve<T>()))
+				return static_cast<T*>(instance);
+
+			converted = Any(arg).TryConvert<T>();  // a converted temporary is created only if a conversion is needed
+
+			return converted.TryCast<T>();
+		}
+
+		/*
+		* a column of arguments (or objects) for a batch of calls, the i-th call uses the element at Data + i * Stride:
+		* a single argument shared by all the calls has stride 0, a column of AnyRef has no type (each element has its own type
+		* and constness); the elements of a const column must not be modified
+		*/
+		struct BatchColumn
+		{
+			const void *Data;
+			std::size_t Stride;
+			const TypeDescriptor *Type;
+			bool IsConst;
+		};
+
+		template <typename T>
+		BatchColumn MakeBatchColumn(Span<T> elements)
+		{
+			if constexpr (std::is_same_v<RawType<T>, AnyRef>)
+				return { elements.data(), sizeof(T), nullptr, false };
+			else
+				return { elements.data(), sizeof(T), Resolve<RawType<T>>(), std::is_const_v<T> };
+		}
+
+		// where a reflected call stores its returned value: an Any, raw storage for an object of the returned type or nowhere
+		struct ResultStorage
+		{
+			Any *Slot;
+			void *Raw;
+		};
+
+		template <typename Ret, typename F>
+		void StoreResult(const ResultStorage &result, F &&call)
+		{
+			using U = RawType<Ret>;
+
+			if constexpr (std::is_void_v<Ret>)
+			{
+				call();
+
+				if (result.Slot)
+					result.Slot->Reset();
+			}
+			else if (result.Raw)
+				new(result.Raw) U(call());  // a referenced object is copied
+			else if (!result.Slot)
+				call();
+			else if constexpr (std::is_reference_v<Ret>)
+				*result.Slot = AnyRef(call());
+			else if constexpr (std::is_move_assignable_v<U>)
+			{
+				if (result.Slot->GetType() == Resolve<U>() && !result.Slot->IsRef())
+					*static_cast<U*>(result.Slot->Get()) = call();  // reuse the object (and its storage) already in the slot
+				else
+					result.Slot->template EmplaceInvoke<U>(std::forward<F>(call));  // construct the returned object in place
+			}
+			else
+				result.Slot->template EmplaceInvoke<U>(std::forward<F>(call));
+		}
+
+	}  // namespace Details
+
+	// containers of Any (i.e. std::vector) move their elements when they grow instead of copying them
+	static_assert(std::is_nothrow_move_constructible_v<Any> && std::is_nothrow_move_assignable_v<Any>, "moving an Any must not throw");
+
+}  // namespace Reflect
+
+#endif  // META_ANY_H
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <tuple>
+#include <utility>
+
+namespace Reflect
+{
+
+	template <typename T>
+	class FieldAccessor;
+
+	namespace Details
+	{
+
+		/*
+		* byte offset of a data member from its member pointer: the member pointer is applied to a suitably aligned
+		* address (as for base offsets), only the address of the data member is computed, no object is accessed
+		*/
+		template <typename Class, typename Type>
+		std::size_t GetMemberOffset(Type Class::*dataMemberPtr)
+		{
+			const Class *object = reinterpret_cast<const Class*>(std::uintptr_t(0x1000) * alignof(Class));
+
+			return reinterpret_cast<const char*>(&(object->*dataMemberPtr)) - reinterpret_cast<const char*>(object);
+		}
+
+	}  // namespace Details
+
+	// result of the non throwing data member accessors
+	enum class AccessStatus
+	{
+		Success,
+		BadObject,  // the object can't be cast to the data member's class
+		BadValue,   // the value can't be cast or converted to the data member's type
+		ReadOnly    // the data member is const
+	};
+
+	class DataMember
+	{
+	public:
+		const std::string &GetName() const { return mName; }
+		const TypeDescriptor *GetParent() const { return mParent; }
+		const TypeDescriptor *GetType() const { return mType; }
+		bool IsReadOnly() const { return mIsReadOnly; }
+
+		static constexpr std::size_t NO_OFFSET = static_cast<std::size_t>(-1);
+
+		/*
+		* byte offset of the data member in an object of objectType (the data member's class if nullptr, or a class derived from it
+		* through non virtual bases); NO_OFFSET if the data member isn't stored at a fixed offset (i.e. accessed through a setter and a getter).
+		* Together with GetType() it allows raw copies of the data member (memcpy of GetType()->GetSize() bytes for trivially copyable types)
+		*/
+		std::size_t GetOffset(const TypeDescriptor *objectType = nullptr) const;
+
+		/*
+		* typed accessor for hot loops: the type is checked once, here (T must be the data member's type, const qualified if the
+		* data member is const), the accessor then reads and writes the data member at native speed; the accessor is invalid
+		* if the type doesn't match or the data member has no fixed offset in objectType
+		*/
+		template <typename T>
+		FieldAccessor<T> Accessor(const TypeDescriptor *objectType = nullptr) const
+		{
+			if (std::is_reference_v<T> || Details::Resolve<Details::RawType<T>>() != mType || (mIsReadOnly && !std::is_const_v<T>))
+				return FieldAccessor<T>();
+
+			return FieldAccessor<T>(GetOffset(objectType));
+		}
+
+		// throw BadCastException if the object or the value can't be cast
+		void Set(AnyRef objectRef, const Any &value) const
+		{
+			ThrowIfFailed(TrySet(objectRef, value), objectRef, value);
+		}
+
+		// the value held by an rvalue Any is moved into the data member (or to a setter taking it by value or by rvalue reference)
+		void Set(AnyRef objectRef, Any &&value) const
+		{
+			ThrowIfFailed(TrySet(objectRef, std::move(value)), objectRef, value);
+		}
+
+		// returns a copy of the data member (use GetRef to avoid copying it)
+		Any Get(AnyRef objectRef) const
+		{
+			Any value;
+
+			if (TryGet(objectRef, value) != AccessStatus::Success)
+				throw BadCastException(mParent, objectRef.GetType());
+
+			return value;
+		}
+
+		/*
+		* non owning view of the data member in place (no copies nor allocations), empty if the object can't be cast, if the data member
+		* is read only (use GetConstRef) or if it isn't stored in the object (a getter that doesn't return a reference)
+		*/
+		AnyRef GetRef(AnyRef objectRef) const
+		{
+			return GetRefImpl(objectRef, true);
+		}
+
+		// const view of the data member (it can be taken from a const object)
+		AnyRef GetConstRef(AnyRef objectRef) const
+		{
+			return GetRefImpl(objectRef, false);
+		}
+
+		/*
+		* copies the data member of each object into a column of (constructed) objects of the data member's type, elements
+		* stride bytes apart (packed if stride is 0); Scatter copies them back. The cast of the objects and the data member's offset
+		* are resolved once for the whole batch (once per object for a Span of AnyRef), objects that can't be cast are skipped;
+		* return the number of objects copied from (to)
+		*/
+		template <typename T>
+		std::size_t Gather(Span<T> objects, void *column, std::size_t stride = 0) const
+		{
+			return GatherWith(Details::MakeBatchColumn(objects), false, objects.size(), column, stride);
+		}
+
+		template <typename T>
+		std::size_t Scatter(Span<T> objects, const void *column, std::size_t stride = 0) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, objects.size(), column, stride ? stride : mType->GetSize(), false);
+		}
+
+		// sets the data member of each object to value (an object of the data member's type)
+		template <typename T>
+		std::size_t Fill(Span<T> objects, const void *value) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, objects.size(), value, 0, false);
+		}
+
+		// sets the data member of the i-th object to *values[i] (an object of the data member's type)
+		template <typename T>
+		std::size_t ScatterIndirect(Span<T> objects, Span<const void* const> values) const
+		{
+			return ScatterWith(Details::MakeBatchColumn(objects), false, std::min(objects.size(), values.size()), values.data(), sizeof(void*), true);
+		}
+
+		// objects are (non null) pointers to objects of objectType
+		std::size_t Gather(Span<void* const> objects, const TypeDescriptor *objectType, void *column, std::size_t stride = 0) const
+		{
+			return GatherWith({ objects.data(), sizeof(void*), objectType, false }, true, objects.size(), column, stride);
+		}
+
+		std::size_t Scatter(Span<void* const> objects, const TypeDescriptor *objectType, const void *column, std::size_t stride = 0) const
+		{
+			return ScatterWith({ objects.data(), sizeof(void*), objectType, false }, true, objects.size(), column, stride ? stride : mType->GetSize(), false);
+		}
+
+		// don't throw nor allocate on failure (mismatches can be probed cheaply)
+		AccessStatus TrySet(AnyRef objectRef, const Any &value) const
+		{
+			return TrySetWith(objectRef, value, false);
+		}
+
+		AccessStatus TrySet(AnyRef objectRef, Any &&value) const
+		{
+			return TrySetWith(objectRef, value, !value.IsRef());  // an AnyRef's object isn't owned by the Any, it's copied
+		}
+
+		AccessStatus TryGet(AnyRef objectRef, Any &value) const  // value's object is reused if it's of the data member's type
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			AccessStatus status = TryGetImpl(objectRef, value);
+			REFLECT_CALL_RESULT(scope, status == AccessStatus::Success);
+
+			return status;
+		}
+
+	protected:
+		DataMember(const std::string &name, const TypeDescriptor *type, const TypeDescriptor *parent, std::size_t offset = NO_OFFSET, bool isReadOnly = false)
+			: mName(name), mType(type), mParent(parent), mOffset(offset), mIsReadOnly(isReadOnly) {}
+
+		/*
+		* calls visit(i, Class*) for each object of a column of objects (or of pointers to objects if isIndirect), objects at a fixed
+		* offset from Class (the common case) are visited by a plain strided loop; returns the number of objects visited
+		*/
+		template <typename Class, typename F>
+		static std::size_t ForEachObject(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, F &&visit)
+		{
+			const TypeDescriptor *classType = Details::Resolve<Class>();
+			const char *data = static_cast<const char*>(objects.Data);
+
+			auto getObject = [data, &objects, isIndirect](std::size_t index) -> char*
+			{
+				const char *element = data + index * objects.Stride;
+
+				return isIndirect ? *reinterpret_cast<char* const*>(element) : const_cast<char*>(element);
+			};
+
+			if (!objects.Type)  // AnyRef column: each object has its own type
+			{
+				std::size_t visited = 0;
+
+				for (std::size_t i = 0; i < count; ++i)
+				{
+					const AnyRef &objectRef = *reinterpret_cast<const AnyRef*>(data + i * objects.Stride);
+
+					if (Class *object = objectRef.TryCast<Class>())  // const views are skipped unless Class is const
+					{
+						visit(i, object);
+						++visited;
+					}
+				}
+
+				return visited;
+			}
+
+			if (objects.IsConst && !std::is_const_v<Class>)  // the objects can't be modified
+				return 0;
+
+			std::ptrdiff_t offset = 0;
+
+			if (objects.Type != classType)
+			{
+				const Details::BaseCast *baseCast = objects.Type->FindBaseCast(classType);
+
+				if (!baseCast)
+					return 0;
+
+				if (baseCast->Step)  // derived through a virtual base: cast each object
+				{
+					for (std::size_t i = 0; i < count; ++i)
+						visit(i, static_cast<Class*>(objects.Type->Cast(getObject(i), classType)));
+
+					return count;
+				}
+
+				offset = baseCast->Offset;
+			}
+
+			if (isIndirect)
+				for (std::size_t i = 0; i < count; ++i)
+					visit(i, reinterpret_cast<Class*>(*reinterpret_cast<char* const*>(data + i * objects.Stride) + offset));
+			else
+				for (std::size_t i = 0; i < count; ++i)
+					visit(i, reinterpret_cast<Class*>(const_cast<char*>(data) + i * objects.Stride + offset));
+
+			return count;
+		}
+
+		// the index-th value of a column scattered to the objects (see ScatterWith)
+		template <typename T>
+		static const T &ColumnValue(const char *column, std::size_t stride, bool isIndirectColumn, std::size_t index)
+		{
+			const char *element = column + index * stride;
+
+			return isIndirectColumn ? **reinterpret_cast<const T* const*>(element) : *reinterpret_cast<const T*>(element);
+		}
+
+	private:
+		AccessStatus TrySetWith(AnyRef objectRef, const Any &value, bool isMovable) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			AccessStatus status = TrySetImpl(objectRef, value, isMovable);
+			REFLECT_CALL_RESULT(scope, status == AccessStatus::Success);
+
+			return status;
+		}
+
+		std::size_t GatherWith(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, void *column, std::size_t stride) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t copied = GatherImpl(objects, isIndirect, count, static_cast<char*>(column), stride ? stride : mType->GetSize());
+			REFLECT_BATCH_RESULT(scope, count, copied);
+
+			return copied;
+		}
+
+		// a stride of 0 copies the same value to every object, the elements of an indirect column are pointers to the values
+		std::size_t ScatterWith(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const void *column, std::size_t stride, bool isIndirectColumn) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t copied = ScatterImpl(objects, isIndirect, count, static_cast<const char*>(column), stride, isIndirectColumn);
+			REFLECT_BATCH_RESULT(scope, count, copied);
+
+			return copied;
+		}
+
+		void ThrowIfFailed(AccessStatus status, AnyRef objectRef, const Any &value) const
+		{
+			if (status == AccessStatus::BadObject)
+				throw BadCastException(mParent, objectRef.GetType(), "object:");
+
+			if (status == AccessStatus::BadValue)
+				throw BadCastException(mType, value.GetType(), "value:");
+		}
+
+		// the value's object can be moved from if isMovable is true (converted temporaries are always moved from)
+		virtual AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const = 0;
+		virtual AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const = 0;
+		virtual AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const = 0;
+		virtual std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const = 0;
+		virtual std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const = 0;
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const DataMember *dataMember = static_cast<const DataMember*>(metaObject);
+
+			stats.TypeName = dataMember->mParent->GetName();
+			stats.Kind = "data member";
+			stats.Description = dataMember->mName;
+		}
+#endif
+
+		std::string mName;                 
+		const TypeDescriptor *mType;    // type of the data member
+		const TypeDescriptor *mParent;  // type of the data member's class
+		std::size_t mOffset;            // offset in an object of the data member's class (NO_OFFSET if not stored at a fixed offset)
+		bool mIsReadOnly;
+
+		REFLECT_STATS_ID(&DataMember::Describe)
+	};
+
+	inline std::size_t DataMember::GetOffset(const TypeDescriptor *objectType) const
+	{
+		if (mOffset == NO_OFFSET || !objectType || objectType == mParent)
+			return mOffset;
+
+		const Details::BaseCast *baseCast = objectType->FindBaseCast(mParent);
+
+		if (!baseCast || baseCast->Step)  // not derived from the data member's class or derived through a virtual base
+			return NO_OFFSET;
+
+		return mOffset + baseCast->Offset;
+	}
+
+	/*
+	* reads and writes a data member of type T (const T for read only data members) at a fixed offset,
+	* object must point to an object of the type the accessor was created for
+	*/
+	template <typename T>
+	class FieldAccessor
+	{
+	public:
+		FieldAccessor() : mOffset(DataMember::NO_OFFSET) {}  // invalid accessor
+
+		bool IsValid() const { return mOffset != DataMember::NO_OFFSET; }
+		explicit operator bool() const { return IsValid(); }
+
+		std::size_t GetOffset() const { return mOffset; }
+
+		T &Get(void *object) const
+		{
+			return *reinterpret_cast<T*>(static_cast<char*>(object) + mOffset);
+		}
+
+		const T &Get(const void *object) const
+		{
+			return *reinterpret_cast<const T*>(static_cast<const char*>(object) + mOffset);
+		}
+
+		template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+		void Set(void *object, const T &value) const
+		{
+			Get(object) = value;
+		}
+
+	private:
+		friend class DataMember;
+
+		explicit FieldAccessor(std::size_t offset) : mOffset(offset) {}
+
+		std::size_t mOffset;
+	};
+
+	template <typename Class, typename Type>
+	class PtrDataMember : public DataMember
+	{
+	public:
+		PtrDataMember(Type Class::*dataMemberPtr, const std::string name)
+			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>(), Details::GetMemberOffset(dataMemberPtr), std::is_const_v<Type>), mDataMemberPtr(dataMemberPtr) {}
+
+		// AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
+		// {
+		// 	return SetImpl(objectRef, value, isMovable);  // use SFINAE
+		// }
+
+		AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
+		{
+			return SetImpl(objectRef, value, isMovable, std::is_const<Type>());  // use tag dispatch
+		}
+
+		AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const override
+		{
+			const Class *obj = objectRef.TryCast<const Class>();
+
+			if (!obj)
+				return AccessStatus::BadObject;
+
+			Details::StoreResult<Details::RawType<Type>>({ &value, nullptr }, [&]() -> Details::RawType<Type> { return obj->*mDataMemberPtr; });
+
+			return AccessStatus::Success;
+		}
+
+		AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const override
+		{
+			if (!isMutable)
+			{
+				const Class *obj = objectRef.TryCast<const Class>();
+
+				return obj ? AnyRef(obj->*mDataMemberPtr) : AnyRef();
+			}
+
+			Class *obj = objectRef.TryCast<Class>();
+
+			if (!obj || std::is_const_v<Type>)
+				return AnyRef();
+
+			return AnyRef(obj->*mDataMemberPtr);
+		}
+
+		std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const override
+		{
+			return ForEachObject<const Class>(objects, isIndirect, count, [this, column, stride](std::size_t index, const Class *obj)
+			{
+				*reinterpret_cast<Details::RawType<Type>*>(column + index * stride) = obj->*mDataMemberPtr;
+			});
+		}
+
+		std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const override
+		{
+			if constexpr (std::is_const_v<Type>)
+				return 0;
+			else
+				return ForEachObject<Class>(objects, isIndirect, count, [this, column, stride, isIndirectColumn](std::size_t index, Class *obj)
+				{
+					obj->*mDataMemberPtr = ColumnValue<Type>(column, stride, isIndirectColumn, index);
+				});
+		}
+
+	private:
+		Type Class::*mDataMemberPtr;
+
+		////// use SFINAE
+		// template <typename U = Type, typename = typename std::enable_if<!std::is_const<U>::value>::type>
+		// void SetImpl(Any object, const Any value)
+		// {
+		// 	Class *obj = object.TryCast<Class>();
+		// 	if (!obj)
+		// 		throw BadCastException(Details::Resolve<Type>()->GetName(), object.GetType()->GetName(), "object:");
+	
+		// 	Any val = value.TryConvert<Type>();
+	
+		// 	if (!val)
+		// 		throw BadCastException(Details::Resolve<Type>()->GetName(), value.GetType()->GetName(), "value:");
+		// 	obj->*mDataMemberPtr = val.TryCast<Type>();
+		// }
+
+		// template <typename U = Type, typename = typename std::enable_if<std::is_const<U>::value>::type, typename = void>
+		// void SetImpl(Any object, const Any value)
+		// {
+		// 	static_assert(false, "can't set const data member");
+		// }
+
+		////// use tag dispatch
+		AccessStatus SetImpl(AnyRef objectRef, const Any &value, bool isMovable, std::false_type) const
+		{
+			Class *obj = objectRef.TryCast<Class>();  // pointers to members of base class can be used with derived class
+
+			if (!obj)
+				return AccessStatus::BadObject;
+
+			Any converted;
+			Type *casted = Details::CastOrConvert<Type>(value, converted);  // converted only if the value isn't a Type
+
+			if (!casted)
+				return AccessStatus::BadValue;
+
+			if (isMovable || converted)
+				obj->*mDataMemberPtr = std::move(*casted);
+			else
+				obj->*mDataMemberPtr = *casted;
+
+			return AccessStatus::Success;
+		}
+
+		AccessStatus SetImpl(AnyRef, const Any&, bool, std::true_type) const
+		{
+			//static_assert(false, "can't set const data member");
+			return AccessStatus::ReadOnly;
+		}
+	};
+
+	// helper meta function to get info about functions passed as auto non type params (C++17)
+	template <typename>
+	struct FunctionHelper;
+
+	template <typename Ret, typename... Args>
+	struct FunctionHelper<Ret(Args...)>
+	{
+		using ReturnType = Ret;
+		using ParamsTypes = std::tuple<Args...>;
+	};
+
+	template <typename Class, typename Ret, typename... Args>
+	/*constexpr*/ FunctionHelper<Ret(/*Class, */Args...)> ToFunctionHelper(Ret(Class::*)(Args...));
+
+	template <typename Class, typename Ret, typename... Args>
+	/*constexpr*/ FunctionHelper<Ret(/*Class, */Args...)> ToFunctionHelper(Ret(Class::*)(Args...) const);
+
+	template <typename Ret, typename... Args>
+	/*constexpr*/ FunctionHelper<Ret(Args...)> ToFunctionHelper(Ret(*)(Args...));
+
+	template <auto Setter, auto Getter, typename Class>
+	class SetGetDataMember : public DataMember
+	{
+	private:
+		using MemberType = Details::RawType<typename decltype(ToFunctionHelper(Getter))::ReturnType>;
+		using SetterParams = typename decltype(ToFunctionHelper(Setter))::ParamsTypes;
+		using SetterParamType = std::tuple_element_t<std::tuple_size_v<SetterParams> - 1, SetterParams>;  // the value is the last parameter
+		using GetterClass = std::conditional_t<std::is_invocable_v<decltype(Getter), const Class&>, const Class, Class>;  // a const getter reads const objects
+
+	public:
+		SetGetDataMember(const std::string name)
+			: DataMember(name, Details::Resolve<MemberType>(), Details::Resolve<Class>()) {}
+
+		AccessStatus TrySetImpl(AnyRef objectRef, const Any &value, bool isMovable) const override
+		{
+			Class *obj = objectRef.TryCast<Class>();
+
+			if (!obj)
+				return AccessStatus::BadObject;
+
+			Any converted;
+			MemberType *casted = Details::CastOrConvert<MemberType>(value, converted);  // converted only if the value isn't a MemberType
+
+			if (!casted)
+				return AccessStatus::BadValue;
+
+			if (isMovable || converted)
+				CallSetter(obj, std::move(*casted));
+			else
+				CopyToSetter(obj, *casted);
+
+			return AccessStatus::Success;
+		}
+
+		AccessStatus TryGetImpl(AnyRef objectRef, Any &value) const override
+		{
+			GetterClass *obj = objectRef.TryCast<GetterClass>();
+
+			if (!obj)
+				return AccessStatus::BadObject;
+
+			Details::StoreResult<MemberType>({ &value, nullptr }, [obj]() -> MemberType { return CallGetter(obj); });
+
+			return AccessStatus::Success;
+		}
+
+		// only getters returning a reference give access to the data member in place
+		AnyRef GetRefImpl(AnyRef objectRef, bool isMutable) const override
+		{
+			using GetterReturnType = typename decltype(ToFunctionHelper(Getter))::ReturnType;
+
+			if constexpr (std::is_lvalue_reference_v<GetterReturnType>)
+			{
+				if (!isMutable)
+				{
+					GetterClass *obj = objectRef.TryCast<GetterClass>();
+
+					return obj ? AnyRef(std::as_const(CallGetter(obj))) : AnyRef();
+				}
+
+				Class *obj = objectRef.TryCast<Class>();
+
+				if (!obj || std::is_const_v<std::remove_reference_t<GetterReturnType>>)
+					return AnyRef();
+
+				return AnyRef(CallGetter(obj));
+			}
+			else
+				return AnyRef();
+		}
+
+		std::size_t GatherImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, char *column, std::size_t stride) const override
+		{
+			return ForEachObject<GetterClass>(objects, isIndirect, count, [column, stride](std::size_t index, GetterClass *obj)
+			{
+				*reinterpret_cast<MemberType*>(column + index * stride) = CallGetter(obj);
+			});
+		}
+
+		std::size_t ScatterImpl(const Details::BatchColumn &objects, bool isIndirect, std::size_t count, const char *column, std::size_t stride, bool isIndirectColumn) const override
+		{
+			return ForEachObject<Class>(objects, isIndirect, count, [column, stride, isIndirectColumn](std::size_t index, Class *obj)
+			{
+				CopyToSetter(obj, ColumnValue<MemberType>(column, stride, isIndirectColumn, index));
+			});
+		}
+
+	private:
+		static decltype(auto) CallGetter(GetterClass *obj)
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Getter)>)
+				return (obj->*Getter)();
+			else
+			{
+				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Getter)>>);
+
+				return Getter(*obj);
+			}
+		}
+
+		template <typename T>
+		static void CallSetter(Class *obj, T &&value)
+		{
+			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
+				(obj->*Setter)(std::forward<T>(value));
+			else
+			{
+				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Setter)>>);
+
+				Setter(*obj, std::forward<T>(value));
+			}
+		}
+
+		static void CopyToSetter(Class *obj, const MemberType &value)
+		{
+			if constexpr (std::is_rvalue_reference_v<SetterParamType>)
+				CallSetter(obj, MemberType(value));  // the setter only takes rvalues: pass it a copy
+			else
+				CallSetter(obj, value);
+		}
+	};
+
+}  // namespace Reflect
+
+#endif // DATA_MEMBER_H
+#ifndef MEMBER_FUNCTION_H
+#define MEMBER_FUNCTION_H
+
+#include <string>
+#include <vector>
+#include <tuple>
+#include <array>
+#ifndef CONVERSION_H
+#define CONVERSION_H
+
+
+namespace Reflect
+{
+
+	class Conversion
+	{
+	public:
+		const TypeDescriptor *GetFromType() const { return mFromType; }
+		const TypeDescriptor *GetToType() const { return mToType; }
+
+		Any Convert(const void *object) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+			REFLECT_COUNT_CONVERSION();
+
+			return ConvertImpl(object);
+		}
+
+	protected:
+		Conversion(const TypeDescriptor *from, const TypeDescriptor *to)
+			: mFromType(from), mToType(to) {}
+
+	private:
+		virtual Any ConvertImpl(const void *object) const = 0;
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const Conversion *conversion = static_cast<const Conversion*>(metaObject);
+
+			stats.TypeName = conversion->mFromType->GetName();
+			stats.Kind = "conversion";
+			stats.Description = "to " + conversion->mToType->GetName();
+		}
+#endif
+
+		const TypeDescriptor *mFromType;  // type to convert from
+		const TypeDescriptor *mToType;    // type to convert to
+
+		REFLECT_STATS_ID(&Conversion::Describe)
+	};
+
+	template <typename From, typename To>
+	class ConversionImpl : public Conversion
+	{
+	public:
+		ConversionImpl() : Conversion(Details::Resolve<From>(), Details::Resolve<To>()) {}
+
+	private:
+		Any ConvertImpl(const void *object) const override
+		{
+			//return To(*static_cast<const From*>(object));
+			return Any(std::in_place_type<To>, *static_cast<const From*>(object));
+		}
+	};
+
+}
+
+#endif // CONVERSION_H
+#ifndef CONVERSION_PLAN_H
+#define CONVERSION_PLAN_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace Reflect
+{
+
+	namespace Details
+	{
+
+		// how an argument of a given type reaches the type of a parameter
+		struct ArgCast
+		{
+			enum class Kind { Identity, Offset, Cast, Convert };
+
+			Kind CastKind;
+			std::ptrdiff_t Offset;          // pointer adjustment to a base at a fixed offset
+			const TypeDescriptor *From;     // argument type (base reached through a virtual base)
+			const TypeDescriptor *To;       // parameter type
+			const Conversion *ToConversion;
+
+			void *Apply(void *arg, Any &converted) const
+			{
+				switch (CastKind)
+				{
+				case Kind::Identity:
+					return arg;
+				case Kind::Offset:
+					return static_cast<char*>(arg) + Offset;
+				case Kind::Cast:
+					return From->Cast(arg, To);
+				default:
+					converted = ToConversion->Convert(arg);  // a converted temporary is created only if a conversion is needed
+					return converted.Get();
+				}
+			}
+		};
+
+		// the casts of the arguments of a call, for a given list of argument types
+		struct ConversionPlan
+		{
+			std::vector<const TypeDescriptor*> ArgTypes;
+			std::vector<ArgCast> Casts;
+			bool IsFailed = false;         // an argument can't be cast nor converted
+			std::uint64_t Generation = 0;  // casts generation a failed plan was built in
+
+			bool Matches(Span<AnyRef> args) const
+			{
+				for (std::size_t i = 0; i < args.size(); ++i)
+					if (args[i].GetType() != ArgTypes[i])
+						return false;
+
+				return true;
+			}
+		};
+
+		/*
+		* cache of the conversion plans of a function or constructor: a call whose argument types
+		* match a recently used plan skips the search through bases and conversions (lock free),
+		* otherwise the plan is looked up or built under a lock; plans are kept until the cache is destroyed.
+		* Calls that can't be cast or converted are cached as failed plans, dropped once a base or a conversion
+		* is registered (the casts generation changes)
+		*/
+		class ConversionPlanCache
+		{
+		public:
+			// nullptr if the arguments can't be cast or converted to the parameters
+			const ConversionPlan *Find(Span<AnyRef> args, Span<const TypeDescriptor* const> paramTypes)
+			{
+				for (auto &recent : mRecentPlans)
+					if (const ConversionPlan *plan = recent.load(std::memory_order_acquire); plan && plan->Matches(args) && !IsStale(plan))
+						return plan->IsFailed ? nullptr : plan;
+
+				std::lock_guard<std::mutex> lock(mMutex);
+
+				const ConversionPlan *plan = nullptr;
+
+				for (auto it = mPlans.begin(); it != mPlans.end(); ++it)
+					if ((*it)->Matches(args))
+					{
+						if (IsStale(it->get()))
+						{
+							Retire(it);
+							break;
+						}
+
+						plan = it->get();
+						break;
+					}
+
+				if (!plan)
+				{
+					std::uint64_t generation = GetCastsGeneration().load(std::memory_order_acquire);  // read before the casts are looked up
+					std::unique_ptr<ConversionPlan> built = Build(args, paramTypes);
+
+					built->Generation = generation;
+					plan = built.get();
+					mPlans.push_back(std::move(built));
+				}
+
+				mRecentPlans[mNextRecent++ % RECENT_PLANS].store(plan, std::memory_order_release);
+
+				return plan->IsFailed ? nullptr : plan;
+			}
+
+		private:
+			static bool IsStale(const ConversionPlan *plan)
+			{
+				return plan->IsFailed && plan->Generation != GetCastsGeneration().load(std::memory_order_acquire);
+			}
+
+			// stale plans are kept alive for readers that may still be matching them (mMutex must be held)
+			void Retire(std::vector<std::unique_ptr<ConversionPlan>>::iterator stale)
+			{
+				for (auto &recent : mRecentPlans)
+					if (recent.load(std::memory_order_relaxed) == stale->get())
+						recent.store(nullptr, std::memory_order_release);
+
+				mRetiredPlans.push_back(std::move(*stale));
+				mPlans.erase(stale);
+			}
+
+			static std::unique_ptr<ConversionPlan> Build(Span<AnyRef> args, Span<const TypeDescriptor* const> paramTypes)
+			{
+				auto plan = std::make_unique<ConversionPlan>();
+
+				for (std::size_t i = 0; i < args.size(); ++i)
+				{
+					const TypeDescriptor *from = args[i].GetType();
+					const TypeDescriptor *to = paramTypes[i];
+
+					plan->ArgTypes.push_back(from);
+
+					if (!from)
+					{
+						plan->IsFailed = true;
+						continue;
+					}
+
+					ArgCast argCast{ ArgCast::Kind::Identity, 0, from, to, nullptr };
+
+					if (from != to)
+					{
+						if (const BaseCast *baseCast = from->FindBaseCast(to))
+						{
+							argCast.CastKind = baseCast->Step ? ArgCast::Kind::Cast : ArgCast::Kind::Offset;
+							argCast.Offset = baseCast->Offset;
+						}
+						else
+						{
+							for (auto *conversion : from->GetConversions())
+								if (conversion->GetToType() == to)
+									argCast.ToConversion = conversion;
+
+							if (!argCast.ToConversion)
+							{
+								plan->IsFailed = true;
+								continue;
+							}
+
+							argCast.CastKind = ArgCast::Kind::Convert;
+						}
+					}
+
+					plan->Casts.push_back(argCast);
+				}
+
+				return plan;
+			}
+
+			static constexpr std::size_t RECENT_PLANS = 4;
+
+			std::array<std::atomic<const ConversionPlan*>, RECENT_PLANS> mRecentPlans{};
+			std::size_t mNextRecent = 0;  // guarded by mMutex
+			std::mutex mMutex;
+			std::vector<std::unique_ptr<ConversionPlan>> mPlans;
+			std::vector<std::unique_ptr<ConversionPlan>> mRetiredPlans;  // failed plans dropped after new casts were registered
+		};
+
+		// the argument as an object of type (cast to it or converted to it in converted), nullptr if it's neither
+		inline const void *CastOrConvert(AnyRef arg, const TypeDescriptor *type, Any &converted)
+		{
+			if (!arg.GetType())
+				return nullptr;
+
+			if (const void *instance = arg.GetType()->Cast(arg.Get(), type))
+				return instance;
+
+			for (auto *conversion : arg.GetType()->GetConversions())
+				if (conversion->GetToType() == type)
+				{
+					converted = conversion->Convert(arg.Get());
+
+					return converted.Get();
+				}
+
+			return nullptr;
+		}
+
+		// a parameter through which the argument can be modified
+		template <typename T>
+		struct IsMutableReference : std::bool_constant<std::is_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>> {};
+
+		/*
+		* passes a (referenced or converted) argument to a parameter: as an rvalue to a T&& parameter, as an lvalue
+		* otherwise (a parameter taken by value receives a copy, the argument itself is never moved from)
+		*/
+		template <typename Param, typename T>
+		decltype(auto) PassArg(T &arg)
+		{
+			if constexpr (std::is_rvalue_reference_v<Param>)
+				return std::move(arg);
+			else
+				return (arg);
+		}
+
+		// const arguments can only be bound to parameters taken by value or by const reference
+		template <typename... Params, std::size_t... indices>
+		bool CanBindArgs([[maybe_unused]] Span<AnyRef> args, std::index_sequence<indices...>)
+		{
+			return ((!IsMutableReference<Params>::value || !args[indices].IsConst()) && ...);
+		}
+
+		/*
+		* the object an argument is viewed through: arrays and functions decay to pointers (a string literal
+		* is passed as a const char*, not as a char[N]), other arguments are referenced
+		*/
+		template <typename T, typename U = std::remove_reference_t<T>>
+		using ArgView = std::conditional_t<std::is_array_v<U> || std::is_function_v<U>, std::decay_t<U>, U&>;
+
+		// the decayed pointers are held by views, which must outlive the returned references
+		template <typename... Views>
+		std::array<AnyRef, sizeof...(Views)> MakeArgRefs(std::tuple<Views...> &views)
+		{
+			return std::apply([](auto&... view) { return std::array<AnyRef, sizeof...(Views)>{ AnyRef(view)... }; }, views);
+		}
+
+	}  // namespace Details
+
+}  // namespace Reflect
+
+#endif  // CONVERSION_PLAN_H
+
+namespace Reflect
+{
+
+	class Function;
+
+	namespace Details
+	{
+
+		/*
+		* BatchArg reads the elements of a column as T, the cast or conversion to T
+		* is resolved once per batch (once per call only for columns of AnyRef);
+		* the elements of a const column can only be read as a const T. Objects
+		* (IS_OBJECT) are only cast, never converted: a call on a converted
+		* temporary would lose its side effects
+		*/
+		template <typename T, bool IS_OBJECT = false>
+		class BatchArg
+		{
+		public:
+			bool Resolve(const BatchColumn &column)
+			{
+				mColumn = &column;
+
+				if (column.IsConst && !std::is_const_v<T>)
+					return false;
+
+				if (!column.Type)
+					mMode = Mode::Dynamic;
+				else if (column.Type == Details::Resolve<T>())
+					mMode = Mode::Direct;
+				else if (const BaseCast *baseCast = column.Type->FindBaseCast(Details::Resolve<T>()))
+				{
+					mMode = baseCast->Step ? Mode::Cast : Mode::Offset;  // only bases reached through a virtual base are cast per element
+					mOffset = baseCast->Offset;
+				}
+				else if constexpr (IS_OBJECT)
+					return false;
+				else
+				{
+					for (auto *conversion : column.Type->GetConversions())
+						if (conversion->GetToType() == Details::Resolve<T>())
+							mConversion = conversion;
+
+					if (!mConversion)
+						return false;
+
+					mMode = Mode::Convert;
+				}
+
+				if (column.Stride == 0)  // shared argument: cast or convert it once
+				{
+					mShared = Read(0);
+					mMode = Mode::Shared;
+
+					return mShared != nullptr;
+				}
+
+				return true;
+			}
+
+			T *Get(std::size_t index)
+			{
+				return mMode == Mode::Shared ? mShared : Read(index);
+			}
+
+		private:
+			enum class Mode { Direct, Offset, Cast, Convert, Dynamic, Shared };
+
+			T *Read(std::size_t index)
+			{
+				void *element = const_cast<void*>(static_cast<const void*>(static_cast<const char*>(mColumn->Data) + index * mColumn->Stride));
+
+				switch (mMode)
+				{
+				case Mode::Direct:
+					return static_cast<T*>(element);
+				case Mode::Offset:
+					return reinterpret_cast<T*>(static_cast<char*>(element) + mOffset);
+				case Mode::Cast:
+					return static_cast<T*>(mColumn->Type->Cast(element, Details::Resolve<T>()));
+				case Mode::Convert:
+					mConverted = mConversion->Convert(element);
+					return mConverted.TryCast<T>();
+				case Mode::Dynamic:
+				{
+					const AnyRef &ref = *static_cast<AnyRef*>(element);
+
+					if constexpr (IS_OBJECT)
+						return ref.TryCast<T>();
+					else
+						return std::is_const_v<T> || !ref.IsConst() ? CastOrConvert<T>(ref, mConverted) : nullptr;
+				}
+				default:
+					return mShared;
+				}
+			}
+
+			const BatchColumn *mColumn = nullptr;
+			Mode mMode = Mode::Direct;
+			std::ptrdiff_t mOffset = 0;
+			const Conversion *mConversion = nullptr;
+			Any mConverted;
+			T *mShared = nullptr;
+		};
+
+		// how a batch reads an argument for a parameter: only arguments bound to a non const reference can be modified
+		template <typename Param>
+		using BatchArgType = std::conditional_t<IsMutableReference<Param>::value, RawType<Param>, const RawType<Param>>;
+
+		// T&& parameters of a batch receive a copy of the argument: a shared argument is passed to every call
+		template <typename Param, typename T>
+		decltype(auto) PassBatchArg(T &arg)
+		{
+			if constexpr (std::is_rvalue_reference_v<Param>)
+				return RawType<Param>(arg);
+			else
+				return (arg);
+		}
+
+		/*
+		* calls a function (through its thunk) once for each element of the object column and stores the returned values in results (if not empty),
+		* C is void for free functions (const for const member functions), returns the number of calls made (calls whose object or arguments
+		* can't be cast or converted are skipped)
+		*/
+		template <typename C, typename Ret, typename... Args, typename Thunk, std::size_t... indices>
+		std::size_t InvokeBatch(Thunk thunk, const Function *function, const BatchColumn &objects, [[maybe_unused]] Span<const BatchColumn> args, std::size_t count, Span<Any> results, std::index_sequence<indices...>)
+		{
+			[[maybe_unused]] std::conditional_t<std::is_void_v<C>, int, BatchArg<C, true>> object{};
+			[[maybe_unused]] std::tuple<BatchArg<BatchArgType<Args>>...> batchArgs;
+
+			if constexpr (!std::is_void_v<C>)
+				if (!object.Resolve(objects))
+					return 0;
+
+			if (!(std::get<indices>(batchArgs).Resolve(args[indices]) && ...))
+				return 0;
+
+			std::size_t calls = 0;
+
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				[[maybe_unused]] std::tuple<BatchArgType<Args>*...> argsTuple{ std::get<indices>(batchArgs).Get(i)... };
+				[[maybe_unused]] C *obj = nullptr;
+
+				bool isValid = (std::get<indices>(argsTuple) && ...);
+
+				if constexpr (!std::is_void_v<C>)
+					isValid = isValid && (obj = object.Get(i));
+
+				if (!isValid)
+				{
+					if (!results.empty())
+						results[i].Reset();
+
+					continue;
+				}
+
+				auto call = [&]() -> Ret
+				{
+					if constexpr (std::is_void_v<C>)
+						return thunk(function, PassBatchArg<Args>(*std::get<indices>(argsTuple))...);
+					else
+						return thunk(function, *obj, PassBatchArg<Args>(*std::get<indices>(argsTuple))...);
+				};
+
+				StoreResult<Ret>({ results.empty() ? nullptr : &results[i], nullptr }, call);
+
+				++calls;
+			}
+
+			return calls;
+		}
+
+	}  // namespace Details
+
+	/*
+	* Invoker is a typed handle to a reflected function, it calls the function directly
+	* with native arguments (no Any, no casts or conversions and no virtual calls)
+	*/
+	template <typename Signature>
+	class Invoker;
+
+	template <typename Ret, typename... Args>
+	class Invoker<Ret(Args...)>
+	{
+		friend class Function;
+
+	public:
+		Invoker() : mFunction(nullptr), mThunk(nullptr) {}
+
+		explicit operator bool() const { return mThunk != nullptr; }
+
+		Ret operator()(Args... args) const
+		{
+			return mThunk(mFunction, std::forward<Args>(args)...);
+		}
+
+	private:
+		using Thunk = Ret(*)(const Function*, Args...);
+
+		Invoker(const Function *function, Thunk thunk) : mFunction(function), mThunk(thunk) {}
+
+		const Function *mFunction;
+		Thunk mThunk;
+	};
+
+	class Function
+	{
+	public:
+		const std::string &GetName() const { return mName; }
+		const TypeDescriptor *GetParent() const { return mParent; }
+
+		template <typename... Args>
+		Any Invoke(AnyRef object, Args&&... args) const
+		{
+			Any result;
+			InvokeInto(object, result, args...);
+
+			return result;
+		}
+
+		/*
+		* invokes the function and stores the returned value in result, the object already held by result is assigned
+		* (reusing its storage) if it's of the return type; returns false (and resets result) if the call can't be made
+		*/
+		template <typename... Args>
+		bool InvokeInto(AnyRef object, Any &result, Args&&... args) const
+		{
+			if (InvokeWith(object, { &result, nullptr }, args...))
+				return true;
+
+			result.Reset();
+
+			return false;
+		}
+
+		/*
+		* invoke with arguments only known at run time (i.e. the stack slots of a script VM), the arguments
+		* are passed to the function without being copied (pass a Span, other containers are taken as a single argument)
+		*/
+		Any Invoke(AnyRef object, Span<AnyRef> args) const
+		{
+			Any result;
+			InvokeInto(object, result, args);
+
+			return result;
+		}
+
+		bool InvokeInto(AnyRef object, Any &result, Span<AnyRef> args) const
+		{
+			if (args.size() == mParamTypes.size() && Dispatch(object, args, { &result, nullptr }))
+				return true;
+
+			result.Reset();
+
+			return false;
+		}
+
+		/*
+		* invokes the function and constructs the returned value in storage (uninitialized memory with the size and alignment of the return type),
+		* type must be the return type (a referenced object is copied); the caller owns the constructed object
+		*/
+		template <typename... Args>
+		bool InvokeInto(AnyRef object, void *storage, const TypeDescriptor *type, Args&&... args) const
+		{
+			return type == mReturnType && InvokeWith(object, { nullptr, storage }, args...);
+		}
+
+		/*
+		* returns an invoker if Signature is the exact signature of the function, an empty invoker otherwise:
+		* Ret(Args...) for free functions, Ret(C&, Args...) for member functions and Ret(const C&, Args...) for const member functions
+		*/
+		template <typename Signature>
+		Invoker<Signature> Bind() const
+		{
+			if (Details::GetTypeId<Signature>() == mSignature)  // the signature is checked once, when binding
+				return Invoker<Signature>(this, reinterpret_cast<typename Invoker<Signature>::Thunk>(mThunk));
+
+			return Invoker<Signature>();
+		}
+
+		/*
+		* invokes the function once for each object with the same arguments, casts and conversions are resolved once for the whole batch;
+		* results (if not empty, it must have at least as many elements as objects) receive the returned values,
+		* returns the number of calls made
+		*/
+		template <typename T, typename... Args>
+		std::size_t InvokeBatch(Span<T> objects, Span<Any> results, Args&&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size() || (!results.empty() && results.size() < objects.size()))
+				return 0;
+
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);
+			std::array<Details::BatchColumn, sizeof...(Args)> columns;
+
+			for (std::size_t i = 0; i < argRefs.size(); ++i)
+				columns[i] = { &argRefs[i], 0, nullptr, false };  // shared arguments (each AnyRef keeps its constness)
+
+			return DispatchBatch(Details::MakeBatchColumn(objects), columns, objects.size(), results);
+		}
+
+		/*
+		* invokes the function once for each object, the i-th call takes its arguments from the i-th element of each column
+		* (each column must have at least as many elements as objects)
+		*/
+		template <typename T, typename... Columns>
+		std::size_t InvokeBatchColumns(Span<T> objects, Span<Any> results, Span<Columns>... columns) const
+		{
+			if (sizeof...(Columns) != mParamTypes.size() || (!results.empty() && results.size() < objects.size()) || ((columns.size() < objects.size()) || ...))
+				return 0;
+
+			std::array<Details::BatchColumn, sizeof...(Columns)> argColumns{ Details::MakeBatchColumn(columns)... };
+
+			return DispatchBatch(Details::MakeBatchColumn(objects), argColumns, objects.size(), results);
+		}
+
+		const TypeDescriptor *GetReturnType() const
+		{
+			return mReturnType;
+		}
+
+		std::vector<const TypeDescriptor*> GetParamTypes() const
+		{
+			return mParamTypes;
+		}
+
+		const TypeDescriptor *GetParamType(size_t index) const
+		{
+			return mParamTypes[index];
+		}
+
+		std::size_t GetNumParams() const
+		{
+			return mParamTypes.size();
+		}
+
+	protected:
+		using Thunk = void(*)();  // type erased function that calls the stored function pointer (cast back to the exact type by Bind)
+
+		Function(const std::string &name, const TypeDescriptor *parent, const TypeDescriptor *returnType, const std::vector<TypeDescriptor const*> paramTypes, TypeId signature, Thunk thunk)
+			: mName(name), mParent(parent), mReturnType(returnType), mParamTypes(paramTypes), mSignature(signature), mThunk(thunk) {}
+
+		const TypeDescriptor *mReturnType;
+		std::vector<TypeDescriptor const *> mParamTypes;
+
+		template <typename... Args>
+		bool InvokeWith(AnyRef object, const Details::ResultStorage &result, Args&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size())
+				return false;
+
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);  // arguments are referenced, not copied (no heap allocations)
+
+			return Dispatch(object, argRefs, result);
+		}
+
+		const Details::ConversionPlan *FindConversionPlan(Span<AnyRef> args) const
+		{
+			return mConversionPlans.Find(args, mParamTypes);
+		}
+
+	private:
+		virtual bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const = 0;
+		virtual std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const = 0;
+
+		// all the calls (except the ones made through a bound invoker) go through here
+		bool Dispatch(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			bool isSuccess = InvokeImpl(object, args, result);
+			REFLECT_CALL_RESULT(scope, isSuccess);
+
+			return isSuccess;
+		}
+
+		std::size_t DispatchBatch(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const
+		{
+			REFLECT_CALL_SCOPE(scope);
+
+			std::size_t calls = InvokeBatchImpl(objects, args, count, results);
+			REFLECT_BATCH_RESULT(scope, count, calls);
+
+			return calls;
+		}
+
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
+		{
+			const Function *function = static_cast<const Function*>(metaObject);
+
+			stats.TypeName = function->mParent ? function->mParent->GetName() : "";
+			stats.Kind = "function";
+			stats.Description = function->mName;
+		}
+#endif
+
+		std::string mName;
+		TypeDescriptor const *const mParent;
+
+		TypeId mSignature;
+		Thunk mThunk;
+
+		mutable Details::ConversionPlanCache mConversionPlans;
+
+		REFLECT_STATS_ID(&Function::Describe)
+	};
+
+
+	template <typename Ret, typename... Args>
+	class FreeFunction : public Function
+	{
+	private:
+		using FunPtr = Ret(*)(Args...);
+
+	public:
+		FreeFunction(FunPtr freeFunPtr, const std::string &name)
+			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(Args...)>(), reinterpret_cast<Thunk>(&FreeFunction::Call)), mFreeFunPtr(freeFunPtr) {}
+
+	private:
+		static Ret Call(const Function *function, Args... args)
+		{
+			return static_cast<const FreeFunction*>(function)->mFreeFunPtr(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<void, Ret, Args...>(&FreeFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(args, result, std::index_sequence_for<Args...>());
+		}
+
+		template <size_t... indices>
+		bool InvokeImpl(Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
+		{
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
+
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
+
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
 
-			return typeDescriptor;
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return mFreeFunPtr(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
 
-		template <typename Type>
-		TypeDescriptor *&GetTypeDescriptorPtr()
-		{
-			static TypeDescriptor *typeDescriptorPtr = nullptr;  // single instance of type descriptor ptr per reflected type
+		FunPtr mFreeFunPtr;
+	};
 
-			return typeDescriptorPtr;
-		}
 
-		inline auto &GetTypeRegistry()
-		{
-			static std::map<std::string, TypeDescriptor*> typeRegistry;
+	template <typename... Args>
+	class FreeFunction<void, Args...> : public Function
+	{
+	private:
+		using FunPtr = void(*)(Args...);
 
-			return typeRegistry;
-		}
+	public:
+		FreeFunction(FunPtr freeFunPtr, const std::string &name)
+			: Function(name, nullptr, Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<void(Args...)>(), reinterpret_cast<Thunk>(&FreeFunction::Call)), mFreeFunPtr(freeFunPtr) {}
 
-		template <typename Type>
-		inline constexpr auto GetTypeSize() -> typename std::enable_if<!std::is_same<RawType<Type>, void>::value, std::size_t>::type
+	private:
+		static void Call(const Function *function, Args... args)
 		{
-			return sizeof(Type);
+			static_cast<const FreeFunction*>(function)->mFreeFunPtr(std::forward<Args>(args)...);
 		}
 
-		template <typename Type>
-		inline constexpr auto GetTypeSize() -> typename std::enable_if<std::is_same<RawType<Type>, void>::value, std::size_t>::type
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
 		{
-			return 0U;
+			return Details::InvokeBatch<void, void, Args...>(&FreeFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
 		}
 
-		template <typename Type>
-		TypeDescriptor *Resolve()
+		bool InvokeImpl(AnyRef, Span<AnyRef> args, const Details::ResultStorage &result) const override
 		{
-			TypeDescriptor *&typeDescPtr = GetTypeDescriptorPtr<RawType<Type>>();
-
-			if (!typeDescPtr)  // create a type descriptor if not present
-			{
-				TypeDescriptor &typeDesc = GetTypeDescriptor<RawType<Type>>();			
-				typeDescPtr = &typeDesc;  
-
-				typeDesc.mSize = GetTypeSize<Type>();
-
-				typeDesc.mIsVoid = std::is_void_v<Type>;
-				typeDesc.mIsIntegral = std::is_integral_v<Type>;
-				typeDesc.mIsFloatingPoint = std::is_floating_point_v<Type>;
-				typeDesc.mIsArray = std::is_array_v<Type>;
-				typeDesc.mIsPointer = std::is_pointer_v<Type>;
-				typeDesc.mIsPointerToDataMember = std::is_member_object_pointer_v<Type>;
-				typeDesc.mIsPointerToMemberFunction = std::is_member_function_pointer_v<Type>;
-				typeDesc.mIsNullPointer = std::is_null_pointer_v<Type>;
-				//typeDesc.mIsLValueReference = std::is_lvalue_reference_v<Type>;
-				//typeDesc.mIsRValueReference = std::is_rvalue_reference_v<Type>;
-				typeDesc.mIsClass = std::is_class_v<std::remove_pointer_t<Type>>;
-				typeDesc.mIsUnion = std::is_union_v<Type>;
-				typeDesc.mIsEnum = std::is_enum_v<Type>;
-				typeDesc.mIsFunction = std::is_function_v<Type>;
-			}
-
-			return typeDescPtr;
+			return InvokeImpl(args, result, std::index_sequence_for<Args...>());
 		}
 
-		template <typename Type>
-		TypeDescriptor *Resolve(Type &&object)
+		template <size_t... indices>
+		bool InvokeImpl(Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			if (!GetTypeDescriptorPtr<RawType<Type>>())
-				(void)Resolve<Type>();
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			return GetTypeDescriptorPtr<RawType<Type>>();
-		}
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-		inline TypeDescriptor *Resolve(const std::string &name)
-		{
-			if (auto it = GetTypeRegistry().find(name); it != GetTypeRegistry().end())
-				return it->second;
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			return nullptr;
-		}
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
 
+			Details::StoreResult<void>(result, [&]() -> void { return mFreeFunPtr(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
 
-	}     // namespace Details
+			return true;
+		}
 
-	bool CanCastOrConvert(const TypeDescriptor *from, const TypeDescriptor *to);
+		FunPtr mFreeFunPtr;
+	};
 
 
-	/******** reflected constructor ********/
-	class Constructor
+	template <typename C, typename Ret, typename... Args>
+	class MemberFunction : public Function
 	{
+	private:
+		using MemFunPtr = Ret(C::*)(Args...);
+
 	public:
-		Any NewInstance(std::vector<Any> &args)
-		{
-			if (args.size() == mParamTypes.size())
-				return NewInstanceImpl(args);
+		MemberFunction(MemFunPtr memFun, const std::string &name)
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(C&, Args...)>(), reinterpret_cast<Thunk>(&MemberFunction::Call)), mMemFunPtr(memFun) {}
 
-			return Any();
+	private:
+		static Ret Call(const Function *function, C &object, Args... args)
+		{
+			return (object.*static_cast<const MemberFunction*>(function)->mMemFunPtr)(std::forward<Args>(args)...);
 		}
 
-		template <typename... Args>
-		Any NewInstance(Args&&... args) const
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
 		{
-			if (sizeof...(Args) == mParamTypes.size())
-			{
-				auto argsAny = std::vector<Any>({ Any(std::forward<Args>(args))... });
-				return NewInstanceImpl(argsAny);
-			}
-
-			return Any();
+			return Details::InvokeBatch<C, Ret, Args...>(&MemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
 		}
 
-		TypeDescriptor const *GetParent() const 
-		{ 
-			return mParent; 
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
-		TypeDescriptor const *GetParamType(size_t index) const 
+		template <size_t... indices>
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			return mParamTypes[index];
-		}
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-		size_t GetNumParams() const 
-		{ 
-			return mParamTypes.size(); 
-		}
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-		template <typename... Args, size_t... indices>
-		bool CanConstruct(std::index_sequence<indices...> indexSequence = std::index_sequence_for<Args...>()) const
-		{
-			return GetNumParams() == sizeof...(Args) && ((Reflect::CanCastOrConvert(Details::Resolve<Args>(), GetParamType(indices))) && ...);
-		}
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-	protected:
-		Constructor(TypeDescriptor *parent, const std::vector<const TypeDescriptor*> &paramTypes) : mParent(parent), mParamTypes(paramTypes) {}
+			C *obj = object.TryCast<C>();  // a const object can't be bound to a non const member function
 
-	private:
-		virtual Any NewInstanceImpl(std::vector<Any> &args) const = 0;
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
 
-		TypeDescriptor *mParent;
-		std::vector<TypeDescriptor const*> mParamTypes;
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return (obj->*mMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
+		}
+
+		MemFunPtr mMemFunPtr;
 	};
 
-	template <typename Type, typename... Args>
-	class ConstructorImpl : public Constructor
+
+	template <typename C, typename... Args>
+	class MemberFunction<C, void, Args...> : public Function
 	{
+	private:
+		using MemFunPtr = void(C::*)(Args...);
+
 	public:
-		ConstructorImpl() : Constructor(Details::Resolve<Type>(), { Details::Resolve<Args>().../*Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()...*/ }) {}
+		MemberFunction(MemFunPtr memFun, const std::string &name)
+			: Function(name, Details::Resolve<C>(), Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<void(C&, Args...)>(), reinterpret_cast<Thunk>(&MemberFunction::Call)), mMemFunPtr(memFun) {}
 
 	private:
-		Any NewInstanceImpl(std::vector<Any> &args) const override
+		static void Call(const Function *function, C &object, Args... args)
 		{
-			return NewInstanceImpl(args, std::make_index_sequence<sizeof...(Args)>());
+			(object.*static_cast<const MemberFunction*>(function)->mMemFunPtr)(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
+		{
+			return Details::InvokeBatch<C, void, Args...>(&MemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any NewInstanceImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
+
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			if ((std::get<indices>(argsTuple) && ...))
-				return Type(*std::get<indices>(argsTuple)...);
+			C *obj = object.TryCast<C>();  // a const object can't be bound to a non const member function
 
-			return Any();
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
+
+			Details::StoreResult<void>(result, [&]() -> void { return (obj->*mMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
+
+		MemFunPtr mMemFunPtr;
 	};
 
-	template <typename Type, typename... Args>
-	class FreeFunConstructor : public Constructor
+
+	template <typename C, typename Ret, typename... Args>
+	class ConstMemberFunction : public Function
 	{
 	private:
-		typedef Type(*CtorFun)(Args...);
+		using ConstMemFunPtr = Ret(C::*)(Args...) const;
+
 	public:
-		FreeFunConstructor(CtorFun ctorFun) : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }), mCtorFun(ctorFun) {}
-	
+		ConstMemberFunction(ConstMemFunPtr constMemFun, const std::string &name)
+			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... },
+			Details::GetTypeId<Ret(const C&, Args...)>(), reinterpret_cast<Thunk>(&ConstMemberFunction::Call)), mConstMemFunPtr(constMemFun) {}
+
 	private:
-		Any NewInstanceImpl(std::vector<Any> &args) const override
+		static Ret Call(const Function *function, const C &object, Args... args)
+		{
+			return (object.*static_cast<const ConstMemberFunction*>(function)->mConstMemFunPtr)(std::forward<Args>(args)...);
+		}
+
+		std::size_t InvokeBatchImpl(const Details::BatchColumn &objects, Span<const Details::BatchColumn> args, std::size_t count, Span<Any> results) const override
 		{
-			return NewInstanceImpl(args, std::make_index_sequence<sizeof...(Args)>());
+			return Details::InvokeBatch<const C, Ret, Args...>(&ConstMemberFunction::Call, this, objects, args, count, results, std::index_sequence_for<Args...>());
+		}
+
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result) const override
+		{
+			return InvokeImpl(object, args, result, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any NewInstanceImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool InvokeImpl(AnyRef object, Span<AnyRef> args, const Details::ResultStorage &result, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
+
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-			if ((std::get<indices>(argsTuple) && ...))
-				return mCtorFun(*std::get<indices>(argsTuple)...);
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-			return Any();
+			const C *obj = object.TryCast<const C>();
+
+			if (!obj || !(std::get<indices>(argsTuple) && ...))  // object and all arguments must be valid
+				return false;
+
+			Details::StoreResult<Ret>(result, [&]() -> Ret { return (obj->*mConstMemFunPtr)(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });
+
+			return true;
 		}
-		
-		CtorFun mCtorFun;
+
+		ConstMemFunPtr mConstMemFunPtr;
 	};
 
+}  // namespace Reflect
 
-	/******** reflected data member ********/
-	class DataMember
+#endif  // MEMBER_FUNCTION_H
+#ifndef CONSTRUCTOR_H
+#define CONSTRUCTOR_H
+
+#include <vector>
+#include <tuple>
+#include <array>
+#ifndef BASE_H
+#define BASE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace Reflect
+{
+
+	class Base
 	{
 	public:
-		std::string GetName() const { return mName; }
-		const TypeDescriptor *GetParent() const { return mParent; }
 		const TypeDescriptor *GetType() const { return mType; }
+		const TypeDescriptor *GetParent() const { return mParent; }
+
+		bool IsVirtual() const { return mIsVirtual; }
+		std::ptrdiff_t GetOffset() const { return mOffset; }  // pointer adjustment from the derived to the base object (non virtual bases only)
 
-		virtual void Set(AnyRef objectHandle, const Any value) = 0; 
-		virtual Any Get(Any object) = 0;                                
+		virtual void *Cast(void *object) = 0;
 
 	protected:
-		DataMember(const std::string &name, const TypeDescriptor *type, const TypeDescriptor *parent)
-			: mName(name), mType(type), mParent(parent) {}
+		Base(TypeDescriptor const *type, const TypeDescriptor *parent, bool isVirtual, std::ptrdiff_t offset)
+			: mParent(parent), mType(type), mIsVirtual(isVirtual), mOffset(offset) {}
 
 	private:
-		std::string mName;
-		const TypeDescriptor *mType;
 		const TypeDescriptor *mParent;
+		const TypeDescriptor *mType;
+
+		bool mIsVirtual;
+		std::ptrdiff_t mOffset;
 	};
 
-	template <typename Class, typename Type>
-	class RawDataMember : public DataMember
+	template <typename B, typename D>
+	class BaseImpl : public Base
 	{
-	public:
-		RawDataMember(Type Class::*dataMemberPtr, const std::string name)
-			: DataMember(name, Details::Resolve<Type>(), Details::Resolve<Class>()), mDataMemberPtr(dataMemberPtr) {}
-
-		// void Set(AnyRef object, const Any value) override
-		// {
-		// 	SetImpl(object, value);  // use SFINAE
-		// }
+	private:
+		// pointers to members of a virtual base can't be converted to pointers to members of the derived class
+		static constexpr bool IsVirtualBase = !std::is_convertible_v<int B::*, int D::*>;
 
-		void Set(AnyRef objectHandle, const Any value) override
-		{
-			SetImpl(objectHandle, value, std::is_const<Type>());  // use tag dispatch
-		}
+	public:
+		BaseImpl() : Base(Details::Resolve<B>(), Details::Resolve<D>(), IsVirtualBase, GetBaseOffset()) {}
 
-		Any Get(Any object) override
+		void *Cast(void *object) override
 		{
-			Class *obj = object.TryCast<Class>();
-
-			if (!obj)
-				throw BadCastException(Resolve<Class>()->GetName(), object.GetType()->GetName());
-
-			return obj->*mDataMemberPtr;
+			return static_cast<B*>(static_cast<D*>(object));
 		}
 
 	private:
-		Type Class::*mDataMemberPtr;
-
-		// ////// use SFINAE
-		// template <typename U = Type, typename = typename std::enable_if<!std::is_const<U>::value>::type>
-		// void SetImpl(Any object, const Any value)
-		// {
-		// 	Class *obj = object.TryCast<Class>();
-		// 	Any val = value.TryConvert<Type>();
-		
-		// 	if (!obj)
-		// 		throw BadCastException(Resolve<Type>()->GetName(), object.GetType()->GetName(), "object:");
-		
-		// 	if (!val)
-		// 		throw BadCastException(Resolve<Type>()->GetName(), value.GetType()->GetName(), "value:");
-		
-		// 	obj->*mDataMemberPtr = val.TryCast<Type>();
-		// }
-
-		// template <typename U = Type, typename = typename std::enable_if<std::is_const<U>::value>::type, typename = void>
-		// void SetImpl(Any object, const Any value)
-		// {
-		// 	static_assert(false, "can't set const data member");
-		// }
-
-		////// use tag dispatch
-		void SetImpl(Any object, const Any value, std::false_type)
+		static std::ptrdiff_t GetBaseOffset()
 		{
-			Class *obj = object.TryCast<Class>();  // pointers to members of base class can be used with derived class
-
-			Type const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<Type>(); !casted)
+			if constexpr (IsVirtualBase)  // the offset of a virtual base depends on the dynamic type of the object
+				return 0;
+			else
 			{
-				val = value.TryConvert<Type>();
-				casted = val.TryCast<Type>();
-			}
+				D *derived = reinterpret_cast<D*>(std::uintptr_t(0x1000) * alignof(D));  // the offset of a non virtual base is known statically, no object is accessed
 
-			if (!obj)
-				throw BadCastException(Details::Resolve<Class>()->GetName(), object.GetType()->GetName(), "object:");
+				return reinterpret_cast<char*>(static_cast<B*>(derived)) - reinterpret_cast<char*>(derived);
+			}
+		}
+	};
 
-			if (!casted)
-				throw BadCastException(Details::Resolve<Type>()->GetName(), value.GetType()->GetName(), "value:");
+}  // namespace Reflect
 
-			obj->*mDataMemberPtr = *casted;
-		}
+#endif // BASE_H
 
-		void SetImpl(Any object, const Any value, std::true_type)
-		{
-			//static_assert(false, "can't set const data member");
-		}
-	};
 
-	// helper meta function to get info about functions passed as auto non type params
-	template <typename>
-	struct FunctionHelper;
+namespace Reflect
+{
 
-	template <typename Ret, typename... Args>
-	struct FunctionHelper<Ret(Args...)>
+	inline bool CanCastOrConvert(const TypeDescriptor *from, const TypeDescriptor *to)
 	{
-		using ReturnType = Ret;
-		using ParamsTypes = std::tuple<Args...>;
-	};
+		if (from == to)
+			return true;
 
-	template <typename Class, typename Ret, typename... Args>
-	/*constexpr*/ FunctionHelper<Ret(/*Class, */Args...)> ToFunctionHelper(Ret(Class::*)(Args...));
+		if (from->HasBase(to))
+			return true;
 
-	template <typename Class, typename Ret, typename... Args>
-	/*constexpr*/ FunctionHelper<Ret(/*Class, */Args...)> ToFunctionHelper(Ret(Class::*)(Args...) const);
+		for (auto *conversion : from->GetConversions())
+			if (conversion->GetToType() == to)
+				return true;
 
-	template <typename Ret, typename... Args>
-	/*constexpr*/ FunctionHelper<Ret(Args...)> ToFunctionHelper(Ret(*)(Args...));
+		return false;
+	}
 
-	template <auto Setter, auto Getter, typename Class> 
-	class SetGetDataMember : public DataMember
+	class Constructor
 	{
-	private:
-		using MemberType = typename decltype(ToFunctionHelper(Getter))::ReturnType;
-
 	public:
-		SetGetDataMember(const std::string name)
-			: DataMember(name, Details::Resolve<MemberType>(), Details::Resolve<Class>()) {}
-
-		void Set(AnyRef objectHandle, const Any value) override
+		Any NewInstance(std::vector<Any> &args)
 		{
-			Any a = objectHandle;
-			Class *obj = a.TryCast<Class>();
+			Any instance;
 
-			MemberType const *casted = nullptr;
-			Any val;
-			if (casted = value.TryCast<MemberType>(); !casted)
+			if (args.size() == mParamTypes.size())
 			{
-				val = value.TryConvert<MemberType>();
-				casted = val.TryCast<MemberType>();
+				std::vector<AnyRef> argRefs(args.begin(), args.end());
+
+				Dispatch(argRefs, { &instance, nullptr });
 			}
 
-			if (!obj)
-				throw BadCastException(Resolve<Class>()->GetName(), Any(objectHandle).GetType()->GetName(), "object:");
+			return instance;
+		}
 
-			if (!casted)
-				throw BadCastException(Resolve<MemberType>()->GetName(), value.GetType()->GetName(), "value:");
+		// construct with arguments only known at run time (no intermediate container, the arguments aren't copied)
+		Any NewInstance(Span<AnyRef> args) const
+		{
+			Any instance;
+			NewInstanceInto(instance, args);
 
-			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
-				(obj->*Setter)(*casted);
-			else
-				Setter(*obj, *casted);
+			return instance;
 		}
 
-		Any Get(Any object) override
+		bool NewInstanceInto(Any &instance, Span<AnyRef> args) const
 		{
-			Class *obj = object.TryCast<Class>();
-
-			if (!obj)
-				throw BadCastException(Resolve<Class>()->GetName(), object.GetType()->GetName());
+			if (args.size() == mParamTypes.size() && Dispatch(args, { &instance, nullptr }))
+				return true;
 
-			if constexpr (std::is_member_function_pointer_v<decltype(Setter)>)
-				return (obj->*Getter)();	
-			else
-			{
-				static_assert(std::is_function_v<std::remove_pointer_t<decltype(Getter)>>);
+			instance.Reset();
 
-				return Getter(*obj);
-			}
+			return false;
 		}
-	};
 
+		template <typename... Args>
+		Any NewInstance(Args&&... args) const
+		{
+			Any instance;
+			NewInstanceInto(instance, args...);
 
-	/******** reflected member function ********/
-	class Function
-	{
-	public:
-		std::string GetName() const { return mName; }
-		const TypeDescriptor *GetParent() const { return mParent; }
+			return instance;
+		}
 
+		/*
+		* constructs the new object in instance, the object already held by instance is assigned
+		* (reusing its storage) if it's of the same type; returns false (and resets instance) if the object can't be constructed
+		*/
 		template <typename... Args>
-		Any Invoke(AnyRef object, Args&&... args) const
+		bool NewInstanceInto(Any &instance, Args&&... args) const
 		{
-			if (sizeof...(Args) == mParamTypes.size())
-			{
-				std::vector<Any> anyArgs{ Any(std::forward<Args>(args))... };
+			if (NewInstanceWith({ &instance, nullptr }, args...))
+				return true;
 
-				return InvokeImpl(object, anyArgs);
-			}
+			instance.Reset();
 
-			return Any();
+			return false;
 		}
 
-		const TypeDescriptor *GetReturnType() const
+		/*
+		* constructs the new object in storage (uninitialized memory with the size and alignment of the object),
+		* type must be the type of the object; the caller owns the constructed object
+		*/
+		template <typename... Args>
+		bool NewInstanceInto(void *storage, const TypeDescriptor *type, Args&&... args) const
 		{
-			return mReturnType;
+			return type == mParent && NewInstanceWith({ nullptr, storage }, args...);
 		}
 
-		std::vector<const TypeDescriptor*> GetParamTypes() const
+		TypeDescriptor const *GetParent() const
 		{
-			return mParamTypes;
+			return mParent;
 		}
 
-		const TypeDescriptor *GetParamType(size_t index) const
+		TypeDescriptor const *GetParamType(size_t index) const
 		{
 			return mParamTypes[index];
 		}
 
-		std::size_t GetNumParams() const
+		size_t GetNumParams() const
 		{
 			return mParamTypes.size();
 		}
 
+		template <typename... Args, size_t... indices>
+		bool CanConstruct(std::index_sequence<indices...> indexSequence = std::index_sequence_for<Args...>()) const
+		{
+			return GetNumParams() == sizeof...(Args) && ((Reflect::CanCastOrConvert(Details::Resolve<Args>(), GetParamType(indices))) && ...);
+		}
+
 	protected:
-		Function(const std::string &name, const TypeDescriptor *parent, const TypeDescriptor *returnType, const std::vector<TypeDescriptor const*> paramTypes)
-			: mName(name), mParent(parent), mReturnType(returnType), mParamTypes(paramTypes) {}
+		Constructor(TypeDescriptor *parent, const std::vector<const TypeDescriptor*> &paramTypes) : mParent(parent), mParamTypes(paramTypes) {}
 
-		const TypeDescriptor *mReturnType;
-		std::vector<TypeDescriptor const *> mParamTypes;
+		const Details::ConversionPlan *FindConversionPlan(Span<AnyRef> args) const
+		{
+			return mConversionPlans.Find(args, mParamTypes);
+		}
 
 	private:
-		virtual Any InvokeImpl(Any object, std::vector<Any> &args) const = 0;
-
-		std::string mName;
-		TypeDescriptor const *const mParent;
-	};
+		template <typename... Args>
+		bool NewInstanceWith(const Details::ResultStorage &instance, Args&... args) const
+		{
+			if (sizeof...(Args) != mParamTypes.size())
+				return false;
 
+			std::tuple<Details::ArgView<Args>...> argViews{ args... };
+			std::array<AnyRef, sizeof...(Args)> argRefs = Details::MakeArgRefs(argViews);  // arguments are referenced, not copied
 
-	template <typename Ret, typename... Args>
-	class FreeFunction : public Function
-	{
-	private:
-		using FunPtr = Ret(*)(Args...);
+			return Dispatch(argRefs, instance);
+		}
 
-	public:
-		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mFreeFunPtr(freeFunPtr) {}
+		virtual bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const = 0;
 
-	private:
-		Any InvokeImpl(Any, std::vector<Any> &args) const override
+		bool Dispatch(Span<AnyRef> args, const Details::ResultStorage &instance) const
 		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
+			REFLECT_CALL_SCOPE(scope);
+
+			bool isSuccess = NewInstanceImpl(args, instance);
+			REFLECT_CALL_RESULT(scope, isSuccess);
+
+			return isSuccess;
 		}
 
-		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+#ifdef REFLECT_INSTRUMENTATION
+		static void Describe(const void *metaObject, MetaObjectStats &stats)
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Constructor *constructor = static_cast<const Constructor*>(metaObject);
 
-			if ((std::get<indices>(argsTuple) && ...))  // all arguments are valid
-				if constexpr (std::is_reference_v<Ret>)
-					return AnyRef(mFreeFunPtr(*std::get<indices>(argsTuple)...));
-				else
-					return mFreeFunPtr(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
+			stats.TypeName = constructor->mParent->GetName();
+			stats.Kind = "constructor";
+			stats.Description = "(";
+
+			for (std::size_t i = 0; i < constructor->mParamTypes.size(); ++i)
+				stats.Description += (i ? ", " : "") + constructor->mParamTypes[i]->GetName();
+
+			stats.Description += ")";
 		}
+#endif
 
-		FunPtr mFreeFunPtr;
-	};
+		TypeDescriptor *mParent;
+		std::vector<TypeDescriptor const*> mParamTypes;
 
+		mutable Details::ConversionPlanCache mConversionPlans;
 
-	template <typename... Args>
-	class FreeFunction<void, Args...> : public Function
-	{
-	private:
-		using FunPtr = void(*)(Args...);
+		REFLECT_STATS_ID(&Constructor::Describe)
+	};
 
+	template <typename Type, typename... Args>
+	class ConstructorImpl : public Constructor
+	{
 	public:
-		FreeFunction(FunPtr freeFunPtr, const std::string &name)
-			: Function(name, nullptr, Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mFreeFunPtr(freeFunPtr) {}
+		ConstructorImpl() : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }) {}
 
 	private:
-		Any InvokeImpl(Any, std::vector<Any> &args) const override
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const override
 		{
-			return InvokeImpl(args, std::index_sequence_for<Args...>());
+			return NewInstanceImpl(args, instance, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			if ((std::get<indices>(argsTuple) && ...))  // all arguments are valid
-				mFreeFunPtr(*std::get<indices>(argsTuple)...);
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-			return Any();
-		}
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
 
-		FunPtr mFreeFunPtr;
-	};
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
 
+			Details::StoreResult<Type>(instance, [&]() -> Type { return Type(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });  // construct the object in place
 
-	template <typename C, typename Ret, typename... Args>
-	class MemberFunction : public Function
+			return true;
+		}
+	};
+
+	template <typename Type, typename... Args>
+	class FreeFunConstructor : public Constructor
 	{
 	private:
-		using MemFunPtr = Ret(C::*)(Args...);
-
+		typedef Type(*CtorFun)(Args...);
 	public:
-		MemberFunction(MemFunPtr memFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mMemFunPtr(memFun) {}
-
+		FreeFunConstructor(CtorFun ctorFun) : Constructor(Details::Resolve<Details::RawType<Type>>(), { Details::Resolve<Details::RawType<Args>>()... }), mCtorFun(ctorFun) {}
+	
 	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance) const override
 		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
+			return NewInstanceImpl(args, instance, std::make_index_sequence<sizeof...(Args)>());
 		}
 
 		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
+		bool NewInstanceImpl(Span<AnyRef> args, const Details::ResultStorage &instance, std::index_sequence<indices...> indexSequence) const
 		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+			const Details::ConversionPlan *plan = FindConversionPlan(args);  // casts and conversions of the arguments are looked up once per list of argument types
 
-			if (C *obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // object is valid and all arguments are valid 
-				if constexpr (std::is_reference_v<Ret>)
-					return AnyRef((obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...));
-				else
-					return (obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
-		}
+			if (!plan || !Details::CanBindArgs<Args...>(args, indexSequence))
+				return false;
 
-		MemFunPtr mMemFunPtr;
+			[[maybe_unused]] std::array<Any, sizeof...(Args)> convertedArgs;  // stays empty unless an argument needs a conversion
+			std::tuple<Details::RawType<Args>*...> argsTuple{ static_cast<Details::RawType<Args>*>(plan->Casts[indices].Apply(args[indices].Get(), convertedArgs[indices]))... };
+
+			if (!(std::get<indices>(argsTuple) && ...))  // all arguments must be valid
+				return false;
+
+			Details::StoreResult<Type>(instance, [&]() -> Type { return mCtorFun(Details::PassArg<Args>(*std::get<indices>(argsTuple))...); });  // construct the returned object in place
+
+			return true;
+		}
+		
+		CtorFun mCtorFun;
 	};
 
+}  // namespace Reflect
 
-	template <typename C, typename... Args>
-	class MemberFunction<C, void, Args...> : public Function
+#endif // CONSTRUCTOR_H
+
+#ifndef TYPE_DESCRIPTOR_INL
+#define TYPE_DESCRIPTOR_INL
+
+#include <algorithm>
+#include <functional>
+
+namespace Reflect
+{
+
+	template <typename Type, typename... Args>
+	void TypeDescriptor::AddConstructor()
 	{
-	private:
-		using MemFunPtr = void(C::*)(Args...);
+		Constructor *constructor = new ConstructorImpl<Type, Args...>();
 
-	public:
-		MemberFunction(MemFunPtr memFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<void>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }),
-			mMemFunPtr(memFun) {}
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mConstructors.push_back(constructor);
+		InvalidateTables(this);
+	}
 
-	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
-		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
-		}
+	template <typename Type, typename... Args>
+	void TypeDescriptor::AddConstructor(Type(*ctorFun)(Args...))
+	{
+		Constructor *constructor = new FreeFunConstructor<Type, Args...>(ctorFun);
 
-		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
-		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mConstructors.push_back(constructor);
+		InvalidateTables(this);
+	}
 
-			if (C *obj = object.TryCast<C>(); (std::get<indices>(argsTuple) && ...) && obj)  // object is valid and all arguments are valid 
-				(obj->*mMemFunPtr)(*std::get<indices>(argsTuple)...);
+	template <typename B, typename T>
+	void TypeDescriptor::AddBase()
+	{
+		Base *base = new BaseImpl<B, T>;
 
-			return Any();
-		}
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mBases.push_back(base);
+		InvalidateTables(this, true);
+	}
 
-		MemFunPtr mMemFunPtr;
-	};
+	template <typename C, typename T>
+	void TypeDescriptor::AddDataMember(T C::*dataMemPtr, const std::string &name)
+	{
+		DataMember *dataMember = new PtrDataMember<C, T>(dataMemPtr, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mDataMembers.push_back(dataMember);
+		InvalidateTables(this);
+	}
 
-	template <typename C, typename Ret, typename... Args>
-	class ConstMemberFunction : public Function
+	template <auto Setter, auto Getter, typename Type>
+	void TypeDescriptor::AddDataMember(const std::string &name)
 	{
-	private:
-		using ConstMemFunPtr = Ret(C::*)(Args...) const;
+		DataMember *dataMember = new SetGetDataMember<Setter, Getter, Type>(name);
 
-	public:
-		ConstMemberFunction(ConstMemFunPtr constMemFun, const std::string &name)
-			: Function(name, Details::Resolve<C>(), Details::Resolve<Ret>(), { Details::Resolve<std::remove_cv_t<std::remove_reference_t<Args>>>()... }), mConstMemFunPtr(constMemFun) {}
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mDataMembers.push_back(dataMember);
+		InvalidateTables(this);
+	}
 
-	private:
-		Any InvokeImpl(Any object, std::vector<Any> &args) const override
-		{
-			return InvokeImpl(object, args, std::make_index_sequence<sizeof...(Args)>());
-		}
+	template <typename Ret, typename... Args>
+	void TypeDescriptor::AddMemberFunction(Ret freeFun(Args...), const std::string &name)
+	{
+		Function *memberFunction = new FreeFunction<Ret, Args...>(freeFun, name);
 
-		template <size_t... indices>
-		Any InvokeImpl(Any object, std::vector<Any> &args, std::index_sequence<indices...> indexSequence) const
-		{
-			std::tuple argsTuple = std::make_tuple(args[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
-			std::vector<Any> convertedArgs{ (std::get<indices>(argsTuple) ? AnyRef(*std::get<indices>(argsTuple)) : args[indices].TryConvert<std::remove_cv_t<std::remove_reference_t<Args>>>())... };
-			argsTuple = std::make_tuple(convertedArgs[indices].TryCast<std::remove_cv_t<std::remove_reference_t<Args>>>()...);
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
+	}
 
-			if (C *obj = object.TryCast<C>(); obj && (std::get<indices>(argsTuple) && ...))  // object is valid and all arguments are valid 
-				if constexpr (std::is_void<Ret>::value)
-				{
-					(obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
+	template <typename C, typename Ret, typename... Args>
+	void TypeDescriptor::AddMemberFunction(Ret(C::*memFun)(Args...), const std::string &name)
+	{
+		Function *memberFunction = new MemberFunction<C, Ret, Args...>(memFun, name);
 
-					return Any();
-				}
-				else
-					if constexpr (std::is_reference_v<Ret>)
-						return AnyRef((obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...));
-					else
-						return (obj->*mConstMemFunPtr)(*std::get<indices>(argsTuple)...);
-			else
-				return Any();
-		}
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
+	}
 
-		ConstMemFunPtr mConstMemFunPtr;
-	};
+	template <typename C, typename Ret, typename... Args>
+	void TypeDescriptor::AddMemberFunction(Ret(C::*memFun)(Args...) const, const std::string &name)
+	{
+		Function *memberFunction = new ConstMemberFunction<C, Ret, Args...>(memFun, name);
 
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mMemberFunctions.push_back(memberFunction);
+		InvalidateTables(this);
+	}
 
-	/******** reflected base class ********/
-	class Base
+	template <typename From, typename To>
+	void TypeDescriptor::AddConversion()
 	{
-	public:
-		const TypeDescriptor *GetType() const { return mType; }
+		Conversion *conversion = new ConversionImpl<From, To>;
 
-		virtual void *Cast(void *object) = 0;
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+		mConversions.push_back(conversion);
+		InvalidateTables(this, true);
+	}
 
-	protected:
-		Base(TypeDescriptor const *type, const TypeDescriptor *parent)
-			: mParent(parent), mType(type) {}
+	inline std::string const &TypeDescriptor::GetName() const
+	{
+		static const std::string unnamed;  // resolved but not registered
+		const std::string *name = mName.load(std::memory_order_acquire);
 
-	private:
-		const TypeDescriptor *mParent;
-		const TypeDescriptor *mType;
-	};
+		return name ? *name : unnamed;
+	}
 
-	template <typename B, typename D>
-	class BaseImpl : public Base
+	inline TypeId TypeDescriptor::GetId() const
 	{
-	public:
-		BaseImpl() : Base(Details::Resolve<B>(), Details::Resolve<D>()) {}
+		return mId;
+	}
 
-		void *Cast(void *object) override
-		{
-			return static_cast<B*>(object);
-		}
-	};
+	inline std::size_t TypeDescriptor::GetSize() const
+	{ 
+		return mSize; 
+	}
 
+	inline Span<Constructor* const> TypeDescriptor::GetConstructors() const
+	{ 
+		return GetTables().Constructors; 
+	}
 
-	/******** reflected conversion function ********/
-	class Conversion
+	template <typename... Args>
+	const Constructor *TypeDescriptor::GetConstructor() const
 	{
-	public:
-		const TypeDescriptor *GetFromType() const { return mFromType; }
-		const TypeDescriptor *GetToType() const { return mToType; }
+		for (auto *constructor : GetTables().Constructors)
+			if (constructor->CanConstruct<Args...>(std::index_sequence_for<Args...>()))
+				//if (constructor->CanConstruct<Args...>(std::make_index_sequence<sizeof...(Args)>()))
+				return constructor;
 
-		virtual Any Convert(const void *object) const = 0;
+		return nullptr;
+	}
 
-	protected:
-		Conversion(const TypeDescriptor *from, const TypeDescriptor *to)
-			: mFromType(from), mToType(to) {}
+	inline Span<Base* const> TypeDescriptor::GetBases() const
+	{ 
+		return GetTables().Bases; 
+	}
 
-	private:
-		const TypeDescriptor *mFromType;  // type to convert from
-		const TypeDescriptor *mToType;    // type to convert to
-	};
+	template <typename B>
+	Base *TypeDescriptor::GetBase() const
+	{
+		for (auto base : GetTables().Bases)
+			if (base->GetType() == Details::Resolve<B>())
+				return base;
 
-	template <typename From, typename To>
-	class ConversionImpl : public Conversion
+		return nullptr;
+	}
+
+	inline bool TypeDescriptor::HasBase(const TypeDescriptor *base) const
 	{
-	public:
-		ConversionImpl() : Conversion(Resolve<From>(), Resolve<To>()) {}
+		return FindBaseCast(base) != nullptr;
+	}
 
-		Any Convert(const void *object) const override
-		{
-			//return To(*static_cast<const From*>(object));
-			return static_cast<To>(*static_cast<const From*>(object));
-		}
-	};
+	inline void *TypeDescriptor::Cast(void *object, const TypeDescriptor *to) const
+	{
+		if (to == this)
+			return object;
 
+		const Details::BaseCast *baseCast = FindBaseCast(to);
 
-	/******** type descriptor ********/
-	class TypeDescriptor
+		if (!baseCast)
+			return nullptr;
+
+		if (!baseCast->Step)
+			return static_cast<char*>(object) + baseCast->Offset;
+
+		return baseCast->Step->Cast(Cast(object, baseCast->From));  // base reached through a virtual base
+	}
+
+	inline const Details::TypeTables &TypeDescriptor::GetTables() const
 	{
-		template <typename> friend class TypeFactory;
-		template <typename> friend TypeDescriptor *Details::Resolve();
-		template <typename T> friend TypeDescriptor *Details::Resolve(T&&);
-	public:
-		template <typename Type, typename... Args>
-		void AddConstructor()
-		{
-			Constructor *constructor = new ConstructorImpl<Type, Args...>();
+		if (const Details::TypeTables *tables = mTables.load(std::memory_order_acquire))  // lock free once the tables are built
+			return *tables;
 
-			mConstructors.push_back(constructor);
-		}
+		return BuildTables();
+	}
 
-		template <typename Type, typename... Args>
-		void AddConstructor(Type(*ctorFun)(Args...))
-		{
-			Constructor *constructor = new FreeFunConstructor<Type, Args...>(ctorFun);
+	inline const Details::TypeTables &TypeDescriptor::BuildTables() const
+	{
+		std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
 
-			mConstructors.push_back(constructor);
-		}
+		if (const Details::TypeTables *tables = mTables.load(std::memory_order_relaxed))  // built by another thread
+			return *tables;
 
-		template <typename B, typename T>
-		void AddBase()
-		{
-			Base *base = new BaseImpl<B, T>;
+		auto tables = std::make_unique<Details::TypeTables>();
 
-			mBases.push_back(base);
-		}
+		tables->Bases = mBases;
+		tables->Conversions = mConversions;
+		tables->Constructors = mConstructors;
 
-		template <typename C, typename T>
-		void AddDataMember(T C::*dataMemPtr, const std::string &name)
-		{
-			DataMember *dataMember = new RawDataMember<C, T>(dataMemPtr, name);
+		CollectBases(tables->BaseCasts, this, 0, true);
+		std::sort(tables->BaseCasts.begin(), tables->BaseCasts.end(), [](const Details::BaseCast &a, const Details::BaseCast &b) { return std::less<const TypeDescriptor*>()(a.Type, b.Type); });
 
-			mDataMembers.push_back(dataMember);
-		}
+		// own meta objects first, then those of each base
+		tables->DataMembers = mDataMembers;
+		tables->MemberFunctions = mMemberFunctions;
 
-		template <auto Setter, auto Getter, typename Type>
-		void AddDataMember(const std::string &name)
+		for (auto *base : mBases)
 		{
-			DataMember *dataMember = new SetGetDataMember<Setter, Getter, Type>(name);
+			for (auto *dataMember : base->GetType()->GetDataMembers())
+				tables->DataMembers.push_back(dataMember);
 
-			mDataMembers.push_back(dataMember);
+			for (auto *memberFunction : base->GetType()->GetMemberFunctions())
+				tables->MemberFunctions.push_back(memberFunction);
 		}
 
-		template <typename Ret, typename... Args>
-		void AddMemberFunction(Ret freeFun(Args...), const std::string &name)
-		{
-			Function *memberFunction = new FreeFunction<Ret, Args...>(freeFun, name);
+		// own meta objects hide inherited ones with the same name
+		tables->DataMemberIndex.Build(tables->DataMembers);
+		tables->MemberFunctionIndex.Build(tables->MemberFunctions);
 
-			mMemberFunctions.push_back(memberFunction);
+		if (!mHasTables)
+		{
+			Details::GetTypesWithTables().push_back(this);
+			mHasTables = true;
 		}
 
-		template <typename C, typename Ret, typename... Args>
-		void AddMemberFunction(Ret(C::*memFun)(Args...), const std::string &name)
-			{
-				Function *memberFunction = new MemberFunction<C, Ret, Args...>(memFun, name);
-	
-				mMemberFunctions.push_back(memberFunction);
-		}
+		const Details::TypeTables *published = tables.get();
+		Details::GetTypeTablesStorage().push_back(std::move(tables));
+		mTables.store(published, std::memory_order_release);
 
-		template <typename C, typename Ret, typename... Args>
-		void AddMemberFunction(Ret(C::*memFun)(Args...) const, const std::string &name)
-		{
-			Function *memberFunction = new ConstMemberFunction<C, Ret, Args...>(memFun, name);
+		return *published;
+	}
 
-			mMemberFunctions.push_back(memberFunction);
-		}
+	inline void TypeDescriptor::InvalidateTables(const TypeDescriptor *changed, bool areCastsChanged)
+	{
+		// the tables of a type include meta objects inherited from its bases (registration mutex must be held)
+		for (auto *type : Details::GetTypesWithTables())
+			if (const Details::TypeTables *tables = type->mTables.load(std::memory_order_relaxed); tables && (type == changed || FindBaseCast(*tables, changed)))
+				type->mTables.store(nullptr, std::memory_order_release);
 
-		template <typename From, typename To>
-		void AddConversion()
+		if (areCastsChanged)  // drops the failed conversion plans cached by functions and constructors
+			Details::GetCastsGeneration().fetch_add(1, std::memory_order_release);
+	}
+
+	inline void TypeDescriptor::CollectBases(std::vector<Details::BaseCast> &baseCasts, const TypeDescriptor *derived, std::ptrdiff_t offset, bool isFixedOffset) const
+	{
+		for (auto *base : derived->mBases)
 		{
-			Conversion *conversion = new ConversionImpl<From, To>;
+			bool isBaseFixedOffset = isFixedOffset && !base->IsVirtual();
+			std::ptrdiff_t baseOffset = offset + base->GetOffset();
+
+			// the first path found to a base is used (i.e. for virtual bases shared in a diamond)
+			if (std::find_if(baseCasts.begin(), baseCasts.end(), [base](const Details::BaseCast &baseCast) { return baseCast.Type == base->GetType(); }) != baseCasts.end())
+				continue;
 
-			mConversions.push_back(conversion);
+			if (isBaseFixedOffset)
+				baseCasts.push_back({ base->GetType(), baseOffset, nullptr, nullptr });
+			else
+				baseCasts.push_back({ base->GetType(), 0, base, derived });
+
+			CollectBases(baseCasts, base->GetType(), baseOffset, isBaseFixedOffset);
 		}
-		
-		std::string const &GetName() const { return mName; }
+	}
 
-		std::size_t GetSize() const { return mSize; }
+	inline const Details::BaseCast *TypeDescriptor::FindBaseCast(const TypeDescriptor *base) const
+	{
+		return FindBaseCast(GetTables(), base);
+	}
 
-		std::vector<Constructor*> GetConstructors() const { return mConstructors; }
+	inline const Details::BaseCast *TypeDescriptor::FindBaseCast(const Details::TypeTables &tables, const TypeDescriptor *base)
+	{
+		const std::vector<Details::BaseCast> &baseCasts = tables.BaseCasts;
 
-		template <typename... Args>
-		const Constructor *GetConstructor() const
+		if (baseCasts.size() <= 8)  // linear search is faster for small hierarchies
 		{
-			for (auto *constructor : mConstructors)
-				if (constructor->CanConstruct<Args...>(std::index_sequence_for<Args...>()))
-					//if (constructor->CanConstruct<Args...>(std::make_index_sequence<sizeof...(Args)>()))
-					return constructor;
+			for (auto &baseCast : baseCasts)
+				if (baseCast.Type == base)
+					return &baseCast;
 
 			return nullptr;
 		}
 
-		std::vector<Base*> GetBases() const { return mBases; }
+		auto it = std::lower_bound(baseCasts.begin(), baseCasts.end(), base, [](const Details::BaseCast &baseCast, const TypeDescriptor *type) { return std::less<const TypeDescriptor*>()(baseCast.Type, type); });
 
-		template <typename B>
-		Base *GetBase() const
-		{
-			for (auto base : mBases)
-				if (base->GetType() == Resolve<B>)
-					return base;
+		return it != baseCasts.end() && it->Type == base ? &*it : nullptr;
+	}
 
-			return nullptr;
-		}
+	inline Span<DataMember* const> TypeDescriptor::GetDataMembers() const
+	{
+		return GetTables().DataMembers;
+	}
+
+	inline DataMember *TypeDescriptor::GetDataMember(std::string_view name) const
+	{
+		return GetDataMember(HashedName(name));
+	}
+
+	inline DataMember *TypeDescriptor::GetDataMember(const HashedName &name) const
+	{
+		return GetTables().DataMemberIndex.Find(name);
+	}
+
+	inline Span<Function* const> TypeDescriptor::GetMemberFunctions() const
+	{
+		return GetTables().MemberFunctions;
+	}
 
-		std::vector<DataMember*> GetDataMembers() const
-		{
-			std::vector<DataMember*> dataMembers(mDataMembers);
+	inline const Function *TypeDescriptor::GetMemberFunction(std::string_view name) const
+	{
+		return GetMemberFunction(HashedName(name));
+	}
 
-			for (auto *base : mBases)
-				for (auto dataMember : base->GetType()->GetDataMembers())
-					dataMembers.push_back(dataMember);
+	inline const Function *TypeDescriptor::GetMemberFunction(const HashedName &name) const
+	{
+		return GetTables().MemberFunctionIndex.Find(name);
+	}
 
-			return dataMembers;
-		}
+	inline Span<Conversion* const> TypeDescriptor::GetConversions() const
+	{ 
+		return GetTables().Conversions; 
+	}
 
-		DataMember *GetDataMember(const std::string &name) const
-		{
-			for (auto *dataMember : mDataMembers)
-				if (dataMember->GetName() == name)
-					return dataMember;
+	template <typename To>
+	Conversion *TypeDescriptor::GetConversion() const
+	{
+		for (auto conversion : GetTables().Conversions)
+			if (conversion->GetToType() == Details::Resolve<To>())
+				return conversion;
 
-			for (auto *base : mBases)
-				if (auto *baseDataMember = base->GetType()->GetDataMember(name))
-					return baseDataMember;
+		return nullptr;
+	}
 
-			return nullptr;
-		}
+}  // namespace Reflect
 
-		std::vector<Function*> GetMemberFunctions() const
-		{
-			std::vector<Function*> memberFunctions(mMemberFunctions);
+#endif  // TYPE_DESCRIPTOR_INL
 
-			for (auto *base : mBases)
-				for (auto memberFunction : base->GetType()->GetMemberFunctions())
-					memberFunctions.push_back(memberFunction);
+#endif // TYPE_DESCRIPTOR_H
+#ifndef FIELDS_H
+#define FIELDS_H
 
-			return memberFunctions;
-		}
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 
-		const Function *GetMemberFunction(const std::string &name) const
-		{
-			for (auto *memberFunction : mMemberFunctions)
-				if (memberFunction->GetName() == name)
-					return memberFunction;
+namespace Reflect
+{
 
-			for (auto *base : mBases)
-				if (auto *memberFunction = base->GetType()->GetMemberFunction(name))
-					return memberFunction;
+	// a data member known at compile time
+	template <typename Class, typename Type>
+	struct Field
+	{
+		using ClassType = Class;
+		using MemberType = Type;
 
-			return nullptr;
-		}
+		const char *Name;
+		Type Class::*Ptr;
+	};
 
-		std::vector<Conversion*> GetConversions() const { return mConversions; }
+	template <typename Class, typename Type>
+	constexpr Field<Class, Type> MakeField(const char *name, Type Class::*ptr)
+	{
+		return { name, ptr };
+	}
 
-		template <typename To>
-		Conversion *GetConversion() const
-		{
-			for (auto conversion : mConversions)
-				if (conversion->GetToType() == Resolve<To>())
-					return conversion;
+	template <typename... Fields>
+	constexpr std::tuple<Fields...> MakeFields(Fields... fields)
+	{
+		return { fields... };
+	}
 
-			return nullptr;
-		}
+	/*
+	* compile time list of the data members of a type, declared once by specializing FieldList:
+	*
+	*	template <>
+	*	struct Reflect::FieldList<Vec3>
+	*	{
+	*		static constexpr auto Fields = Reflect::MakeFields(Reflect::MakeField("x", &Vec3::x), Reflect::MakeField("y", &Vec3::y));
+	*	};
+	*
+	* ForEachField visits the fields of an object with straight-line code (no meta objects involved),
+	* TypeFactory::AddFields registers the same fields as data members of the type descriptor
+	*/
+	template <typename Type>
+	struct FieldList;
 
-	private:
-		std::string mName;
-		std::size_t mSize;
+	template <typename Type, typename = void>
+	struct HasFieldList : std::false_type {};
 
-		// C++ primary type categories
-		bool mIsVoid;
-		bool mIsIntegral;
-		bool mIsFloatingPoint;
-		bool mIsArray;
-		bool mIsPointer;
-		bool mIsPointerToDataMember;
-		bool mIsPointerToMemberFunction;
-		bool mIsNullPointer;
-		//bool mIsLValueReference;
-		//bool mIsRValueReference;
-		bool mIsClass;
-		bool mIsUnion;
-		bool mIsEnum;
-		bool mIsFunction;
+	template <typename Type>
+	struct HasFieldList<Type, std::void_t<decltype(FieldList<Type>::Fields)>> : std::true_type {};
 
-		std::vector<Base*> mBases;
-		std::vector<Conversion*> mConversions;
-		std::vector<Constructor*> mConstructors;
-		std::vector<DataMember*> mDataMembers;
-		std::vector<Function*> mMemberFunctions;
+	template <typename Type>
+	constexpr std::size_t GetFieldCount()
+	{
+		static_assert(HasFieldList<Type>::value, "the type has no compile time field list");
 
-	};
+		return std::tuple_size_v<std::remove_const_t<decltype(FieldList<Type>::Fields)>>;
+	}
 
-	inline bool CanCastOrConvert(const TypeDescriptor *from, const TypeDescriptor *to) 
+	// calls visitor(name, field) for each field of object, in declaration order (fields of a const object are const)
+	template <typename Type, typename Visitor>
+	constexpr void ForEachField(Type &object, Visitor &&visitor)
 	{
-		if (from == to)
-			return true;
+		using Class = std::remove_const_t<Type>;
 
-		for (auto *base : from->GetBases())
-			if (base->GetType() == to)
-				return true;
-
-		for (auto *conversion : from->GetConversions())
-			if (conversion->GetToType() == to)
-				return true;
+		static_assert(HasFieldList<Class>::value, "the type has no compile time field list");
 
-		return false;
+		std::apply([&object, &visitor](const auto&... fields) { (visitor(fields.Name, object.*(fields.Ptr)), ...); }, FieldList<Class>::Fields);
 	}
 
-	/******** type factory ********/
+}  // namespace Reflect
+
+#endif  // FIELDS_H
+
+namespace Reflect
+{
 
 	// fwd declaration
 	template <typename Type>
@@ -924,11 +4210,18 @@ namespace Reflect
 		TypeFactory &ReflectType(const std::string &name)
 		{
 			TypeDescriptor *typeDescriptor = Details::Resolve<Type>();
-			
-			typeDescriptor->mName = name;
-			Details::GetTypeRegistry()[name] = typeDescriptor;
 
-			return typeFactory<Type>;
+			std::lock_guard<std::recursive_mutex> lock(Details::GetRegistrationMutex());
+
+			// the name is set by the first registration only: other threads may be reading it
+			if (!typeDescriptor->mName.load(std::memory_order_relaxed))
+			{
+				typeDescriptor->mNameStorage = name;
+				typeDescriptor->mName.store(&typeDescriptor->mNameStorage, std::memory_order_release);
+				Details::GetTypeRegistry().Insert(typeDescriptor);
+			}
+
+			return *this;
 		}
 
 		template <typename... Args>
@@ -936,7 +4229,7 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->template AddConstructor<Type, Args...>();
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		template <typename... Args>
@@ -954,7 +4247,7 @@ namespace Reflect
 
 			Details::Resolve<Type>()->template AddBase<Base, Type>();
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		template <typename T, typename U = Type>  // default template type param to allow for non class types
@@ -962,7 +4255,15 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->AddDataMember(dataMemPtr, name);
 
-			return typeFactory<Type>;
+			return *this;
+		}
+
+		// registers the compile time field list of the type (see FieldList) as data members
+		TypeFactory &AddFields()
+		{
+			std::apply([this](const auto&... fields) { (AddDataMember(fields.Ptr, fields.Name), ...); }, FieldList<Type>::Fields);
+
+			return *this;
 		}
 
 		template <auto Setter, auto Getter>
@@ -970,7 +4271,7 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->template AddDataMember<Setter, Getter, Type>(name);
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		template <typename Ret, typename... Args>
@@ -978,7 +4279,7 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->AddMemberFunction(freeFun, name);
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		template <typename Ret, typename... Args, typename U = Type>
@@ -986,7 +4287,7 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->AddMemberFunction(memFun, name);
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		template <typename Ret, typename... Args, typename U = Type>
@@ -994,7 +4295,7 @@ namespace Reflect
 		{
 			Details::Resolve<Type>()->AddMemberFunction(constMemFun, name);
 
-			return typeFactory<Type>;
+			return *this;
 		}
 
 		//template <typename FuncType, FuncType Func>
@@ -1004,7 +4305,7 @@ namespace Reflect
 		//	Details::Resolve<Type>()->template AddMemberFunction<FunctType, Func>(name);
 		//	Details::Resolve<Type>()->template AddMemberFunction<Func>(name);
 
-		//	return typeFactory<Type>;
+		//	return *this;
 		//}
 
 		template <typename To>
@@ -1014,15 +4315,26 @@ namespace Reflect
 
 			Details::Resolve<Type>()->template AddConversion<Type, To>();
 
-			return typeFactory<Type>;
+			return *this;
 		}
 	};
 
+}  // namespace Reflect
+
+#endif // TYPE_FACTORY_H
+#include <type_traits>
+#include <utility>
+
+namespace Reflect
+{
+
+	class TypeDescriptor;
 
 	/*
 	* Reflect takes a string which is the mapped name of the
 	* reflected type and returns a TypeFactory, which can be
-	* used to add meta objects to the type descriptor
+	* used to add meta objects to the type descriptor (a type
+	* keeps the name it's first registered with)
 	*/
 
 	template <typename Type>
@@ -1032,12 +4344,13 @@ namespace Reflect
 	}
 
 	/*
-	* three ways to get the type descriptor of a type:
+	* four ways to get the type descriptor of a type:
 	* 1. with a template type parameter
 	* 2. with the name of the type (a string)
-	* 3. with an instance of the object
+	* 3. with the id of the type
+	* 4. with an instance of the object
 	*
-	* returns a const pointer to the type descriptor
+	* each function calls the corresponding internal Resolve and returns a const pointer to the type descriptor
 	*/
 
 	template <typename Type>
@@ -1046,17 +4359,370 @@ namespace Reflect
 		return Details::Resolve<Type>();
 	}
 
-	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string>::value>::type>
+	template <typename T, typename = typename std::enable_if<!std::is_convertible<T, std::string>::value && !std::is_same<Details::RawType<T>, HashedName>::value && !std::is_same<Details::RawType<T>, TypeId>::value>::type>
 	const TypeDescriptor *Resolve(T &&object)
 	{
 		return Details::Resolve(std::forward<T>(object));
 	}
-
+	
 	inline const TypeDescriptor *Resolve(const std::string &name)
 	{
-		return Details::Resolve(name);
+		return Details::GetTypeRegistry().Find(HashedName(name));
+	}
+
+	inline const TypeDescriptor *Resolve(const HashedName &name)
+	{
+		return Details::GetTypeRegistry().Find(name);
+	}
+
+	inline const TypeDescriptor *Resolve(TypeId id)
+	{
+		return Details::GetTypeRegistry().Find(id);
+	}
+
+	// the id of a type is computed at compile time
+	template <typename Type>
+	constexpr TypeId GetTypeId()
+	{
+		return Details::GetTypeId<Details::RawType<Type>>();
+	}
+
+}  // namespace Reflect
+
+#endif  // REFLECT_H
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <cstddef>
+#include <atomic>
+#include <vector>
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <cstddef>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <exception>
+#include <algorithm>
+
+namespace Reflect
+{
+
+	/*
+	* ThreadPool is a small work stealing pool used to run reflected calls in parallel:
+	* each worker owns a queue of tasks, it pops tasks from the back of its own queue
+	* and steals tasks from the front of the other workers' queues when its queue is empty,
+	* the thread that starts a parallel loop runs tasks as well until the loop is done
+	*/
+	class ThreadPool
+	{
+	public:
+		// threadCount includes the calling thread (a pool with 1 thread runs everything on the calling thread)
+		explicit ThreadPool(std::size_t threadCount = std::thread::hardware_concurrency())
+		{
+			std::size_t workerCount = threadCount > 1 ? threadCount - 1 : 0;
+
+			for (std::size_t i = 0; i < workerCount; ++i)
+				mQueues.push_back(std::make_unique<Queue>());
+
+			for (std::size_t i = 0; i < workerCount; ++i)
+				mWorkers.emplace_back([this, i]() { WorkerLoop(i); });
+		}
+
+		ThreadPool(const ThreadPool&) = delete;
+		ThreadPool &operator=(const ThreadPool&) = delete;
+
+		~ThreadPool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mWakeMutex);
+				mStop = true;
+			}
+
+			mWake.notify_all();
+
+			for (auto &worker : mWorkers)
+				worker.join();
+		}
+
+		std::size_t GetThreadCount() const { return mWorkers.size() + 1; }
+
+		/*
+		* splits [0, count) in chunks of grainSize elements and calls body(begin, end) for each chunk on the pool's threads,
+		* returns when all the chunks are done (the first exception thrown by body is rethrown)
+		*/
+		template <typename Body>
+		void ParallelFor(std::size_t count, std::size_t grainSize, Body &&body)
+		{
+			grainSize = std::max<std::size_t>(grainSize, 1U);
+
+			std::size_t chunkCount = (count + grainSize - 1) / grainSize;
+
+			if (chunkCount == 0)
+				return;
+
+			if (mWorkers.empty() || chunkCount == 1)
+			{
+				body(std::size_t(0), count);
+
+				return;
+			}
+
+			Job job;
+			job.Body = [](void *context, std::size_t begin, std::size_t end) { (*static_cast<std::remove_reference_t<Body>*>(context))(begin, end); };
+			job.Context = const_cast<void*>(static_cast<const void*>(std::addressof(body)));
+			job.Remaining = chunkCount;
+
+			{
+				std::lock_guard<std::mutex> lock(mWakeMutex);
+				mPending += chunkCount;  // counted before the tasks are queued so that it never goes below zero
+			}
+
+			for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				Queue &queue = *mQueues[chunk % mQueues.size()];
+				std::lock_guard<std::mutex> lock(queue.Mutex);
+				queue.Tasks.push_back({ &job, chunk * grainSize, std::min(count, (chunk + 1) * grainSize) });
+			}
+
+			mWake.notify_all();
+
+			// help the workers until no task is left, then wait for the chunks still running
+			Task task;
+			while (job.Remaining.load(std::memory_order_acquire) != 0 && Steal(mQueues.size(), task))
+				Run(task);
+
+			std::unique_lock<std::mutex> lock(job.Mutex);
+			job.Done.wait(lock, [&job]() { return job.Remaining.load(std::memory_order_acquire) == 0; });
+
+			if (job.Error)
+				std::rethrow_exception(job.Error);
+		}
+
+	private:
+		struct Job
+		{
+			void (*Body)(void *context, std::size_t begin, std::size_t end);
+			void *Context;
+			std::atomic<std::size_t> Remaining;
+			std::exception_ptr Error;
+			std::mutex Mutex;
+			std::condition_variable Done;
+		};
+
+		struct Task
+		{
+			Job *ParentJob;
+			std::size_t Begin;
+			std::size_t End;
+		};
+
+		struct Queue
+		{
+			std::mutex Mutex;
+			std::deque<Task> Tasks;
+		};
+
+		void WorkerLoop(std::size_t index)
+		{
+			Task task;
+
+			while (true)
+			{
+				if (Pop(index, task) || Steal(index, task))
+				{
+					Run(task);
+
+					continue;
+				}
+
+				std::unique_lock<std::mutex> lock(mWakeMutex);
+				mWake.wait(lock, [this]() { return mStop || mPending != 0; });
+
+				if (mStop)
+					return;
+			}
+		}
+
+		// pop from the back of the worker's own queue
+		bool Pop(std::size_t index, Task &task)
+		{
+			Queue &queue = *mQueues[index];
+			std::lock_guard<std::mutex> lock(queue.Mutex);
+
+			if (queue.Tasks.empty())
+				return false;
+
+			task = queue.Tasks.back();
+			queue.Tasks.pop_back();
+			--mPending;
+
+			return true;
+		}
+
+		// steal from the front of the other queues (index is the thief's own queue, or the number of queues for the calling thread)
+		bool Steal(std::size_t index, Task &task)
+		{
+			for (std::size_t i = 1; i <= mQueues.size(); ++i)
+			{
+				std::size_t victim = (index + i) % mQueues.size();
+
+				if (victim == index)
+					continue;
+
+				Queue &queue = *mQueues[victim];
+				std::lock_guard<std::mutex> lock(queue.Mutex);
+
+				if (queue.Tasks.empty())
+					continue;
+
+				task = queue.Tasks.front();
+				queue.Tasks.pop_front();
+				--mPending;
+
+				return true;
+			}
+
+			return false;
+		}
+
+		void Run(const Task &task)
+		{
+			Job &job = *task.ParentJob;
+
+			try
+			{
+				job.Body(job.Context, task.Begin, task.End);
+			}
+			catch (...)
+			{
+				std::lock_guard<std::mutex> lock(job.Mutex);
+
+				if (!job.Error)
+					job.Error = std::current_exception();
+			}
+
+			// the job lives on the stack of the thread waiting for it, it's decremented under the lock so that it's not destroyed before the notification
+			std::lock_guard<std::mutex> lock(job.Mutex);
+
+			if (job.Remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)  // last chunk: wake the thread waiting for the job
+				job.Done.notify_all();
+		}
+
+		std::vector<std::unique_ptr<Queue>> mQueues;
+		std::vector<std::thread> mWorkers;
+
+		std::mutex mWakeMutex;
+		std::condition_variable mWake;
+		std::atomic<std::size_t> mPending{ 0 };
+		bool mStop = false;
+	};
+
+}  // namespace Reflect
+
+#endif  // THREAD_POOL_H
+
+namespace Reflect
+{
+
+	/*
+	* parallel versions of batch invocation and data member update: the objects are split in chunks
+	* of grainSize objects that run on the pool's threads, each chunk is a batch (casts and conversions
+	* are resolved once per chunk), arguments shared by all the objects must not be modified by the function
+	*/
+
+	template <typename T, typename... Args>
+	std::size_t ParallelInvoke(ThreadPool &pool, std::size_t grainSize, const Function &function, Span<T> objects, Span<Any> results, Args&&... args)
+	{
+		if (!results.empty() && results.size() < objects.size())
+			return 0;
+
+		std::atomic<std::size_t> calls{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			Span<Any> chunkResults = results.empty() ? results : results.subspan(begin, end - begin);
+			calls += function.InvokeBatch(objects.subspan(begin, end - begin), chunkResults, args...);
+		});
+
+		return calls;
+	}
+
+	template <typename T, typename... Columns>
+	std::size_t ParallelInvokeColumns(ThreadPool &pool, std::size_t grainSize, const Function &function, Span<T> objects, Span<Any> results, Span<Columns>... columns)
+	{
+		if ((!results.empty() && results.size() < objects.size()) || ((columns.size() < objects.size()) || ...))
+			return 0;
+
+		std::atomic<std::size_t> calls{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			Span<Any> chunkResults = results.empty() ? results : results.subspan(begin, end - begin);
+			calls += function.InvokeBatchColumns(objects.subspan(begin, end - begin), chunkResults, columns.subspan(begin, end - begin)...);
+		});
+
+		return calls;
+	}
+
+	/*
+	* sets the data member of each object to value, cast or converted once for all the objects (throws BadCastException
+	* if it can't be); each chunk is scattered like a batch, objects that can't be cast are skipped. Returns the number
+	* of objects set
+	*/
+	template <typename T>
+	std::size_t ParallelSet(ThreadPool &pool, std::size_t grainSize, const DataMember &dataMember, Span<T> objects, const Any &value)
+	{
+		Any converted;
+		const void *casted = Details::CastOrConvert(value, dataMember.GetType(), converted);
+
+		if (!casted)
+			throw BadCastException(dataMember.GetType(), value.GetType(), "value:");
+
+		std::atomic<std::size_t> set{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			set += dataMember.Fill(objects.subspan(begin, end - begin), casted);
+		});
+
+		return set;
+	}
+
+	/*
+	* sets the data member of the i-th object to the i-th value (throws BadCastException if a value can't be cast or converted),
+	* values are cast or converted once each, then each chunk is scattered like a batch
+	*/
+	template <typename T>
+	std::size_t ParallelSetColumn(ThreadPool &pool, std::size_t grainSize, const DataMember &dataMember, Span<T> objects, Span<const Any> values)
+	{
+		if (values.size() < objects.size())
+			return 0;
+
+		std::atomic<std::size_t> set{ 0 };
+
+		pool.ParallelFor(objects.size(), grainSize, [&](std::size_t begin, std::size_t end)
+		{
+			std::vector<const void*> casted(end - begin);
+			std::vector<Any> converted(end - begin);  // stay empty unless a value needs a conversion
+
+			for (std::size_t i = begin; i < end; ++i)
+				if (!(casted[i - begin] = Details::CastOrConvert(values[i], dataMember.GetType(), converted[i - begin])))
+					throw BadCastException(dataMember.GetType(), values[i].GetType(), "value:");
+
+			set += dataMember.ScatterIndirect(objects.subspan(begin, end - begin), Span<const void* const>(casted));
+		});
+
+		return set;
 	}
 
-}    // namespace Reflect
+}  // namespace Reflect
+
+#endif  // PARALLEL_H
 
-#endif  // REFLECT_H
\ No newline at end of file
+#endif  // REFLECT_SINGLE_INCLUDE_H
@@ -0,0 +1,336 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <string>
+#include <utility>
+#include <vector>
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+
+namespace
+{
+
+	struct Counted
+	{
+		static inline int sCopies = 0;
+		static inline int sMoves = 0;
+		static inline int sAlive = 0;
+
+		Counted() { ++sAlive; }
+		Counted(const Counted&) { ++sCopies; ++sAlive; }
+		Counted(Counted&&) noexcept { ++sMoves; ++sAlive; }
+		~Counted() { --sAlive; }
+	};
+
+	struct Vec3 { float x, y, z; };
+
+	struct Tracked  // trivially destructible, copied through its operations
+	{
+		int value = 0;
+
+		Tracked() = default;
+		Tracked(const Tracked &other) : value(other.value + 1) {}
+	};
+
+	// trivially copyable payloads have no copy, move nor destroy operation: they're copied with memcpy
+	void TestTrivialOperations()
+	{
+		using Reflect::Details::AnyTypeTraits;
+
+		static_assert(!AnyTypeTraits<int>::Operations.Copy && !AnyTypeTraits<int>::Operations.Move && !AnyTypeTraits<int>::Operations.Destroy);
+		static_assert(!AnyTypeTraits<Vec3>::Operations.Copy && !AnyTypeTraits<Vec3>::Operations.Move && !AnyTypeTraits<Vec3>::Operations.Destroy);
+		CHECK(AnyTypeTraits<std::string>::Operations.Copy && AnyTypeTraits<std::string>::Operations.Move && AnyTypeTraits<std::string>::Operations.Destroy);
+		CHECK(AnyTypeTraits<Tracked>::Operations.Copy && AnyTypeTraits<Tracked>::Operations.Move && !AnyTypeTraits<Tracked>::Operations.Destroy);  // function addresses aren't constants in sanitized builds
+
+		Reflect::Any vec(Vec3{ 1.0f, 2.0f, 3.0f });
+		Reflect::Any copy(vec);
+		Reflect::Any moved(std::move(copy));
+
+		CHECK(moved.TryCast<Vec3>()->z == 3.0f && vec.TryCast<Vec3>()->x == 1.0f);
+
+		Reflect::Any tracked((Tracked()));
+		Reflect::Any trackedCopy(tracked);
+
+		CHECK(trackedCopy.TryCast<Tracked>()->value == tracked.TryCast<Tracked>()->value + 1);  // not copied with memcpy
+	}
+
+	// the operations table is shared by type, an Any holds a buffer, a type and a table pointer
+	void TestSize()
+	{
+		CHECK(sizeof(Reflect::Any) == 32);
+	}
+
+	void TestMoveLeavesSourceEmpty()
+	{
+		Reflect::Any source(std::string(100, 'x'));
+		Reflect::Any target(std::move(source));
+
+		CHECK(!source && !source.GetType());
+		CHECK(*target.TryCast<std::string>() == std::string(100, 'x'));
+	}
+
+	void TestSwap()
+	{
+		Reflect::Any inlined(42);
+		Reflect::Any heap(std::string(100, 'y'));
+		int x = 7;
+		Reflect::Any ref = Reflect::AnyRef(x);
+
+		inlined.Swap(heap);
+		CHECK(*inlined.TryCast<std::string>() == std::string(100, 'y') && *heap.TryCast<int>() == 42);
+
+		heap.Swap(ref);
+		CHECK(heap.TryCast<int>() == &x && *ref.TryCast<int>() == 42);
+	}
+
+	void TestCopiesAndDestruction()
+	{
+		{
+			Reflect::Any any((Counted()));
+			Reflect::Any copy(any);
+			Reflect::Any moved(std::move(copy));
+
+			CHECK(Counted::sCopies == 1 && Counted::sAlive == 2);
+		}
+
+		CHECK(Counted::sAlive == 0);
+	}
+
+	struct ThrowingMove
+	{
+		int value = 3;
+
+		ThrowingMove() = default;
+		ThrowingMove(const ThrowingMove&) = default;
+		ThrowingMove(ThrowingMove &&other) noexcept(false) : value(other.value) {}
+	};
+
+	bool IsInBuffer(const Reflect::Any &any)
+	{
+		const char *object = static_cast<const char*>(any.Get());
+		const char *buffer = reinterpret_cast<const char*>(&any);
+
+		return object >= buffer && object < buffer + sizeof(Reflect::Any);
+	}
+
+	// moving an Any never throws: a vector of Any moves its elements when it grows, objects whose move may throw are heap allocated
+	void TestNothrowMove()
+	{
+		Reflect::Any small(1);
+		Reflect::Any throwing((ThrowingMove()));
+
+		CHECK(IsInBuffer(small));
+		CHECK(!IsInBuffer(throwing) && throwing.TryCast<ThrowingMove>()->value == 3);
+
+		std::vector<Reflect::Any> anys;
+		Counted::sCopies = 0;
+
+		for (int i = 0; i < 100; ++i)
+			anys.emplace_back(Counted());
+
+		CHECK(Counted::sCopies == 0);
+		anys.clear();
+		CHECK(Counted::sAlive == 0);
+	}
+
+	struct Small
+	{
+		static inline int sDestroyed = 0;
+
+		int x, y;
+
+		Small(int x, int y) : x(x), y(y) {}
+		~Small() { ++sDestroyed; }
+	};
+
+	struct Large
+	{
+		static inline int sDestroyed = 0;
+
+		std::string name;
+		double values[4];
+
+		Large(const std::string &name, double value) : name(name), values{ value, value, value, value } {}
+		~Large() { ++sDestroyed; }
+	};
+
+	// objects are constructed in place from constructor arguments, Emplace destroys the previous object first
+	void TestEmplace()
+	{
+		Reflect::Any small(std::in_place_type<Small>, 1, 2);
+		Reflect::Any large(std::in_place_type<Large>, "large", 0.5);
+
+		CHECK(IsInBuffer(small) && small.TryCast<Small>()->y == 2);
+		CHECK(!IsInBuffer(large) && large.TryCast<Large>()->name == "large" && large.TryCast<Large>()->values[3] == 0.5);
+
+		Small::sDestroyed = 0;
+		Large::sDestroyed = 0;
+
+		Large &emplaced = small.Emplace<Large>("emplaced", 1.5);  // inline object replaced by a heap one
+
+		CHECK(Small::sDestroyed == 1 && &emplaced == small.TryCast<Large>() && emplaced.values[0] == 1.5);
+
+		Small &inlined = large.Emplace<Small>(3, 4);  // heap object replaced by an inline one
+
+		CHECK(Large::sDestroyed == 1 && IsInBuffer(large) && &inlined == large.TryCast<Small>() && inlined.x == 3);
+
+		large.Emplace<Small>(5, 6);
+
+		CHECK(Small::sDestroyed == 2 && large.TryCast<Small>()->x == 5);
+	}
+
+	struct alignas(64) OverAligned
+	{
+		float Values[16] = {};
+	};
+
+	// objects that don't fit the SBO buffer are heap allocated with their own alignment
+	void TestOverAligned()
+	{
+		Reflect::Any any((OverAligned()));
+
+		CHECK(reinterpret_cast<std::uintptr_t>(any.Get()) % 64 == 0);
+
+		Reflect::Any copy(any);
+
+		CHECK(reinterpret_cast<std::uintptr_t>(copy.Get()) % 64 == 0);
+	}
+
+	// Any objects with different SBO sizes are copied and moved into each other
+	void TestDifferentBufferSizes()
+	{
+		using BigAny = Reflect::BasicAny<64>;
+
+		BigAny big(std::string(20, 'z'));
+		Reflect::Any small(big);
+
+		CHECK(*small.TryCast<std::string>() == std::string(20, 'z') && *big.TryCast<std::string>() == std::string(20, 'z'));
+
+		BigAny back(std::move(small));
+
+		CHECK(!small && *back.TryCast<std::string>() == std::string(20, 'z'));
+		CHECK(sizeof(BigAny) > sizeof(Reflect::Any));
+	}
+
+	// counts the blocks allocated from a memory resource and the blocks given back to it
+	class CountingResource : public std::pmr::memory_resource
+	{
+	public:
+		int Allocations = 0;
+		int Deallocations = 0;
+
+	private:
+		void *do_allocate(std::size_t size, std::size_t alignment) override
+		{
+			++Allocations;
+
+			return std::pmr::new_delete_resource()->allocate(size, alignment);
+		}
+
+		void do_deallocate(void *memory, std::size_t size, std::size_t alignment) override
+		{
+			++Deallocations;
+			std::pmr::new_delete_resource()->deallocate(memory, size, alignment);
+		}
+
+		bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+		{
+			return this == &other;
+		}
+	};
+
+	using PmrAny = Reflect::BasicAny<sizeof(void*), alignof(std::max_align_t), Reflect::MemoryResourceAllocator>;
+
+	// heap payloads are allocated from the resource of the calling thread and freed through the resource they came from
+	void TestMemoryResourceAllocator()
+	{
+		CountingResource first;
+		CountingResource second;
+
+		Reflect::MemoryResourceAllocator::SetMemoryResource(&first);
+
+		{
+			PmrAny any(std::string(100, 'x'));
+			PmrAny copy(any);
+			PmrAny converted(Reflect::Any(std::string(100, 'y')));  // moved from an Any with another allocator
+
+			CHECK(first.Allocations == 3);
+
+			PmrAny moved(std::move(copy));  // same allocator: the heap object is taken over
+
+			CHECK(first.Allocations == 3 && *moved.TryCast<std::string>() == std::string(100, 'x'));
+			CHECK(*converted.TryCast<std::string>() == std::string(100, 'y'));
+
+			std::thread([other = std::move(any)]() mutable { other.Reset(); }).join();  // freed on a thread using the default resource
+
+			CHECK(first.Deallocations == 1);
+
+			Reflect::MemoryResourceAllocator::SetMemoryResource(&second);
+		}
+
+		CHECK(first.Deallocations == 3);
+		CHECK(second.Allocations == 0 && second.Deallocations == 0);
+
+		Reflect::MemoryResourceAllocator::SetMemoryResource(nullptr);  // back to the default resource
+	}
+
+	struct Big
+	{
+		char text[64] = {};
+	};
+
+	int Length(const std::string &s) { return static_cast<int>(s.size()); }
+	Big Widen(const std::string &s) { Big big; s.copy(big.text, sizeof(big.text) - 1); return big; }
+	std::string Narrow(const Big &big) { return std::string(big.text); }
+
+	// the result slot is also the argument: it must be read before the returned object replaces it
+	void TestResultSlotIsArgument()
+	{
+		const Reflect::Function *length = Reflect::Resolve<std::string>()->GetMemberFunction("Length");
+		const Reflect::Function *widen = Reflect::Resolve<std::string>()->GetMemberFunction("Widen");
+		const Reflect::Function *narrow = Reflect::Resolve<std::string>()->GetMemberFunction("Narrow");
+
+		Reflect::Any slot = std::string(100, 'x');
+
+		CHECK(length->InvokeInto(Reflect::AnyRef(), slot, slot));  // inline result
+		CHECK(*slot.TryCast<int>() == 100);
+
+		slot = std::string("a name long enough to be heap allocated");
+
+		CHECK(widen->InvokeInto(Reflect::AnyRef(), slot, slot));  // heap allocated result
+		CHECK(std::string(slot.TryCast<Big>()->text) == "a name long enough to be heap allocated");
+
+		CHECK(narrow->InvokeInto(Reflect::AnyRef(), slot, slot));
+		CHECK(*slot.TryCast<std::string>() == "a name long enough to be heap allocated");
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<std::string>("string")
+		.AddMemberFunction(&Length, "Length")
+		.AddMemberFunction(&Widen, "Widen")
+		.AddMemberFunction(&Narrow, "Narrow");
+	Reflect::Reflect<Big>("Big");
+	Reflect::Reflect<Counted>("Counted");
+	Reflect::Reflect<OverAligned>("OverAligned");
+	Reflect::Reflect<ThrowingMove>("ThrowingMove");
+	Reflect::Reflect<Vec3>("Vec3");
+	Reflect::Reflect<Tracked>("Tracked");
+	Reflect::Reflect<Small>("Small");
+	Reflect::Reflect<Large>("Large");
+
+	TestSize();
+	TestTrivialOperations();
+	TestMoveLeavesSourceEmpty();
+	TestSwap();
+	TestCopiesAndDestruction();
+	TestNothrowMove();
+	TestEmplace();
+	TestOverAligned();
+	TestDifferentBufferSizes();
+	TestResultSlotIsArgument();
+	TestMemoryResourceAllocator();
+}
@@ -0,0 +1,81 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+
+namespace
+{
+
+	struct A
+	{
+		int a = 1;
+
+		void Bump() { ++a; }
+		int Get() const { return a; }
+	};
+
+	struct Pad { char pad[24] = {}; };
+	struct M : Pad, A { int m = 2; };  // A at a non zero offset
+
+	struct V : virtual A { int v = 3; };
+	struct W : V { int w = 4; };  // A reached through a virtual base
+
+	struct X
+	{
+		int x = 5;
+
+		operator A() const { return A{ x }; }
+	};
+
+	void TestBaseAtOffset()
+	{
+		M objects[3];
+		Reflect::Any results[3];
+
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Bump")->InvokeBatch(Reflect::Span<M>(objects), {}) == 3);
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Get")->InvokeBatch(Reflect::Span<M>(objects), Reflect::Span<Reflect::Any>(results)) == 3);
+
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			CHECK(objects[i].a == 2 && objects[i].m == 2);
+			CHECK(*results[i].TryCast<int>() == 2);
+		}
+	}
+
+	void TestVirtualBase()
+	{
+		W objects[3];
+
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Bump")->InvokeBatch(Reflect::Span<W>(objects), {}) == 3);
+
+		for (const W &object : objects)
+			CHECK(object.a == 2 && object.w == 4);
+	}
+
+	void TestObjectsAreNotConverted()
+	{
+		X objects[3];
+		Reflect::AnyRef refs[3] = { Reflect::AnyRef(objects[0]), Reflect::AnyRef(objects[1]), Reflect::AnyRef(objects[2]) };
+
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Bump")->InvokeBatch(Reflect::Span<X>(objects), {}) == 0);
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Bump")->InvokeBatch(Reflect::Span<Reflect::AnyRef>(refs), {}) == 0);
+		CHECK(Reflect::Resolve<A>()->GetMemberFunction("Get")->InvokeBatch(Reflect::Span<X>(objects), {}) == 0);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<A>("A")
+		.AddDataMember(&A::a, "a")
+		.AddMemberFunction(&A::Bump, "Bump")
+		.AddMemberFunction(&A::Get, "Get");
+	Reflect::Reflect<Pad>("Pad");
+	Reflect::Reflect<M>("M").AddBase<Pad>().AddBase<A>();
+	Reflect::Reflect<V>("V").AddBase<A>();
+	Reflect::Reflect<W>("W").AddBase<V>();
+	Reflect::Reflect<X>("X").AddConversion<A>();
+
+	TestBaseAtOffset();
+	TestVirtualBase();
+	TestObjectsAreNotConverted();
+}
@@ -0,0 +1,142 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <string>
+
+namespace
+{
+
+	struct A { int a = 1; };
+	struct B : A { int b = 2; };
+	struct C : B { int c = 3; };  // A is a grandparent of C
+
+	struct Pad { char pad[24] = {}; };
+	struct M : Pad, C { int m = 4; };  // C (and A) at a non zero offset
+
+	struct V : virtual A { int v = 5; };
+	struct W : V { int w = 6; };  // A reached through a virtual base
+
+	struct Y
+	{
+		int y = 7;
+
+		operator A() const { return A{ y }; }
+	};
+
+	struct Z : A { int z = 8; };  // its base is registered after the first calls
+
+	int GetA(const A &a) { return a.a; }
+
+	struct Label
+	{
+		std::string text;
+
+		Label() = default;
+		explicit Label(const std::string &text) : text(text) {}
+
+		void SetText(const std::string &value) { text = value; }
+	};
+
+	void TestIndirectBases()
+	{
+		C c;
+		Reflect::Any any = Reflect::AnyRef(c);
+
+		CHECK(any.TryCast<A>() == static_cast<A*>(&c));
+		CHECK(Reflect::Resolve<C>()->HasBase(Reflect::Resolve<A>()));
+		CHECK(!Reflect::Resolve<A>()->HasBase(Reflect::Resolve<C>()));
+	}
+
+	void TestNonFirstBase()
+	{
+		M m;
+		Reflect::Any any = Reflect::AnyRef(m);
+
+		CHECK(any.TryCast<C>() == static_cast<C*>(&m));
+		CHECK(any.TryCast<A>() == static_cast<A*>(&m));
+		CHECK(any.TryCast<A>()->a == 1);
+	}
+
+	void TestVirtualBase()
+	{
+		W w;
+		Reflect::Any any = Reflect::AnyRef(w);
+
+		CHECK(any.TryCast<A>() == static_cast<A*>(&w));
+		CHECK(Reflect::Resolve<W>()->GetDataMember("a"));
+	}
+
+	void TestGetBase()
+	{
+		CHECK(Reflect::Resolve<B>()->GetBase<A>());
+		CHECK(!Reflect::Resolve<B>()->GetBase<C>());
+	}
+
+	void TestFailedCallsAfterNewCasts()
+	{
+		const Reflect::Function *getA = Reflect::Resolve<A>()->GetMemberFunction("GetA");
+		Reflect::Any result;
+		Y y;
+		Z z;
+
+		CHECK(!getA->InvokeInto(Reflect::AnyRef(), result, y));
+		CHECK(!getA->InvokeInto(Reflect::AnyRef(), result, y));  // failed plan found in the cache
+		CHECK(!getA->InvokeInto(Reflect::AnyRef(), result, z));
+
+		Reflect::Reflect<Y>("Y").AddConversion<A>();  // the failed plans are dropped
+		Reflect::Reflect<Z>("Z").AddBase<A>();
+
+		CHECK(getA->InvokeInto(Reflect::AnyRef(), result, y));
+		CHECK(*result.TryCast<int>() == 7);
+		CHECK(getA->InvokeInto(Reflect::AnyRef(), result, z));
+		CHECK(*result.TryCast<int>() == 1);
+	}
+
+	// a string literal is passed as a const char* (not as a char array) and converted to the std::string parameter
+	void TestStringLiteralArgument()
+	{
+		const Reflect::Function *setText = Reflect::Resolve<Label>()->GetMemberFunction("SetText");
+		Label label;
+		Reflect::Any result;
+
+		CHECK(setText->InvokeInto(label, result, "hello"));
+		CHECK(label.text == "hello");
+
+		Reflect::Any instance = Reflect::Resolve<Label>()->GetConstructor<std::string>()->NewInstance("world");
+
+		CHECK(instance.TryCast<Label>() && instance.TryCast<Label>()->text == "world");
+
+		Label labels[3];
+
+		CHECK(setText->InvokeBatch(Reflect::Span<Label>(labels), {}, "shared") == 3);
+
+		for (const Label &each : labels)
+			CHECK(each.text == "shared");
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<A>("A").AddDataMember(&A::a, "a").AddMemberFunction(&GetA, "GetA");
+	Reflect::Reflect<B>("B").AddBase<A>();
+	Reflect::Reflect<C>("C").AddBase<B>();
+	Reflect::Reflect<Pad>("Pad");
+	Reflect::Reflect<M>("M").AddBase<Pad>().AddBase<C>();
+	Reflect::Reflect<V>("V").AddBase<A>();
+	Reflect::Reflect<W>("W").AddBase<V>();
+	Reflect::Reflect<Y>("Y");
+	Reflect::Reflect<Z>("Z");
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<const char*>("const char*").AddConversion<std::string>();
+	Reflect::Reflect<Label>("Label")
+		.AddConstructor<std::string>()
+		.AddMemberFunction(&Label::SetText, "SetText");
+
+	TestIndirectBases();
+	TestNonFirstBase();
+	TestVirtualBase();
+	TestGetBase();
+	TestFailedCallsAfterNewCasts();
+	TestStringLiteralArgument();
+}
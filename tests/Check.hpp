@@ -0,0 +1,24 @@
+#ifndef CHECK_H
+#define CHECK_H
+
+#include <cstdio>
+#include <cstdlib>
+
+/*
+* CHECK stays active in release builds (unlike assert): a failed check
+* reports the condition and its location and makes the test exit with a failure
+*/
+#define CHECK(condition) ((condition) ? (void)0 : ::Check::Fail(#condition, __FILE__, __LINE__))
+
+namespace Check
+{
+
+	[[noreturn]] inline void Fail(const char *condition, const char *file, int line)
+	{
+		std::fprintf(stderr, "%s:%d: check failed: %s\n", file, line, condition);
+		std::exit(EXIT_FAILURE);
+	}
+
+}  // namespace Check
+
+#endif  // CHECK_H
@@ -0,0 +1,133 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <atomic>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace
+{
+
+	struct Base { int x = 1; int GetX() const { return x; } };
+	struct Middle : Base { int y = 2; };
+	struct Leaf : Middle { int z = 3; };
+
+	template <int N>
+	struct Numbered : Middle { int n = N; };
+
+	template <int... N>
+	void RegisterNumbered(std::integer_sequence<int, N...>)
+	{
+		(Reflect::Reflect<Numbered<N>>("Numbered" + std::to_string(N)).template AddBase<Middle>().AddDataMember(&Numbered<N>::n, "n"), ...);
+	}
+
+	/*
+	* readers resolve types and read their tables while a writer registers new types and adds meta objects
+	* to a base, which invalidates the tables of the derived types being read
+	*/
+	void TestRegistrationWhileReading()
+	{
+		constexpr int READERS = 4;
+
+		std::atomic<bool> isWriting{ true };
+		std::atomic<int> failures{ 0 };
+		std::vector<std::thread> threads;
+
+		threads.emplace_back([&isWriting]
+		{
+			RegisterNumbered(std::make_integer_sequence<int, 64>());
+			Reflect::Reflect<Base>("Base").AddMemberFunction(&Base::GetX, "GetX");
+			Reflect::Reflect<Middle>("Middle").AddDataMember(&Middle::y, "y");
+
+			isWriting = false;
+		});
+
+		for (int i = 0; i < READERS; ++i)
+			threads.emplace_back([&isWriting, &failures]
+			{
+				Leaf leaf;
+
+				do
+				{
+					const Reflect::TypeDescriptor *leafType = Reflect::Resolve<Leaf>();
+
+					if (!leafType->HasBase(Reflect::Resolve<Base>()) || !leafType->GetDataMember("x"))
+						++failures;
+
+					if (const Reflect::Function *getX = leafType->GetMemberFunction("GetX"); getX && *getX->Invoke(leaf).TryCast<int>() != 1)
+						++failures;
+
+					if (const Reflect::TypeDescriptor *numbered = Reflect::Resolve("Numbered7"); numbered && numbered != Reflect::Resolve<Numbered<7>>())
+						++failures;
+
+					(void)Reflect::Resolve(Reflect::GetTypeId<Numbered<63>>());
+				}
+				while (isWriting);
+			});
+
+		for (auto &thread : threads)
+			thread.join();
+
+		CHECK(failures == 0);
+		CHECK(Reflect::Resolve<Leaf>()->GetMemberFunction("GetX") && Reflect::Resolve<Leaf>()->GetDataMember("y"));
+		CHECK(Reflect::Resolve("Numbered63") == Reflect::Resolve<Numbered<63>>());
+		CHECK(Reflect::Resolve<Numbered<5>>()->GetDataMember("x") && Reflect::Resolve<Numbered<5>>()->GetDataMember("n"));
+	}
+
+	// the name of a type is published when it's first registered, readers see no name or the whole name
+	void TestNameWhileRegistering()
+	{
+		struct Late {};
+
+		std::atomic<int> failures{ 0 };
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < 4; ++i)
+			threads.emplace_back([&failures]
+			{
+				for (int j = 0; j < 1000; ++j)
+					if (const std::string &name = Reflect::Resolve<Late>()->GetName(); !name.empty() && name != "Late")
+						++failures;
+			});
+
+		threads.emplace_back([] { Reflect::Reflect<Late>("Late"); Reflect::Reflect<Late>("Later"); });
+
+		for (auto &thread : threads)
+			thread.join();
+
+		CHECK(failures == 0);
+		CHECK(Reflect::Resolve<Late>()->GetName() == "Late" && Reflect::Resolve("Late") == Reflect::Resolve<Late>());
+	}
+
+	// the first Resolve of a type from several threads at once creates a single descriptor
+	void TestConcurrentFirstResolve()
+	{
+		struct Fresh {};
+
+		std::vector<const Reflect::TypeDescriptor*> resolved(4);
+		std::vector<std::thread> threads;
+
+		for (std::size_t i = 0; i < resolved.size(); ++i)
+			threads.emplace_back([&resolved, i] { resolved[i] = Reflect::Resolve<Fresh>(); });
+
+		for (auto &thread : threads)
+			thread.join();
+
+		for (auto *type : resolved)
+			CHECK(type == resolved[0]);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<Base>("Base").AddDataMember(&Base::x, "x");
+	Reflect::Reflect<Middle>("Middle").AddBase<Base>();
+	Reflect::Reflect<Leaf>("Leaf").AddBase<Middle>().AddDataMember(&Leaf::z, "z");
+
+	TestRegistrationWhileReading();
+	TestConcurrentFirstResolve();
+	TestNameWhileRegistering();
+}
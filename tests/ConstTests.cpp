@@ -0,0 +1,216 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <string>
+#include <utility>
+
+namespace
+{
+
+	struct W
+	{
+		int value = 1;
+
+		void Bump() { ++value; }
+		int Value() const { return value; }
+
+		int GetValue() const { return value; }
+		void SetValue(int v) { value = v; }
+
+		void AddTo(int &total) const { total += value; }
+	};
+
+	struct Counter
+	{
+		explicit Counter(int &count) { ++count; }
+	};
+
+	struct Owner
+	{
+		std::string name;
+
+		Owner() = default;
+		explicit Owner(std::string &&name) : name(std::move(name)) {}
+
+		void Rename(std::string &&value) { name = std::move(value); }
+	};
+
+	void Bump(int &i) { ++i; }
+	int Read(const int &i) { return i; }
+	std::size_t Consume(std::string &&s) { std::string taken(std::move(s)); return taken.size(); }
+
+	void TestConstViews()
+	{
+		const W constW;
+		W w;
+
+		CHECK(Reflect::AnyRef(constW).IsConst());
+		CHECK(!Reflect::AnyRef(w).IsConst());
+		CHECK(!Reflect::AnyRef(constW).TryCast<W>());
+		CHECK(Reflect::AnyRef(constW).TryCast<const W>() == &constW);
+
+		Reflect::Any any = Reflect::AnyRef(constW);
+
+		CHECK(any.IsConstRef());
+		CHECK(any.GetType() == Reflect::Resolve<W>());
+		CHECK(!any.TryCast<W>());
+		CHECK(any.TryCast<const W>() == &constW);
+		CHECK(Reflect::AnyRef(any).IsConst());
+
+		const Reflect::Any constAny = W();
+
+		CHECK(Reflect::AnyRef(constAny).IsConst());
+		CHECK(!Reflect::AnyRef(constAny).TryCast<W>());
+	}
+
+	void TestConstObjectInvoke()
+	{
+		const W constW;
+		W w;
+		Reflect::Any result;
+
+		CHECK(!Reflect::Resolve<W>()->GetMemberFunction("Bump")->InvokeInto(constW, result));
+		CHECK(constW.value == 1);
+		CHECK(Reflect::Resolve<W>()->GetMemberFunction("Bump")->InvokeInto(w, result));
+		CHECK(w.value == 2);
+
+		CHECK(Reflect::Resolve<W>()->GetMemberFunction("Value")->InvokeInto(constW, result));
+		CHECK(*result.TryCast<int>() == 1);
+	}
+
+	void TestConstObjectDataMembers()
+	{
+		const W constW;
+		const Reflect::DataMember *value = Reflect::Resolve<W>()->GetDataMember("value");
+		const Reflect::DataMember *property = Reflect::Resolve<W>()->GetDataMember("property");
+
+		CHECK(value->TrySet(constW, Reflect::Any(5)) == Reflect::AccessStatus::BadObject);
+		CHECK(property->TrySet(constW, Reflect::Any(5)) == Reflect::AccessStatus::BadObject);
+		CHECK(constW.value == 1);
+
+		CHECK(*value->Get(constW).TryCast<int>() == 1);
+		CHECK(*property->Get(constW).TryCast<int>() == 1);
+
+		CHECK(!value->GetRef(constW).Get());
+		CHECK(value->GetConstRef(constW).IsConst());
+		CHECK(value->GetConstRef(constW).TryCast<const int>() == &constW.value);
+
+		const W objects[2];
+		int column[2] = {};
+
+		CHECK(value->Gather(Reflect::Span<const W>(objects), column) == 2);
+		CHECK(value->Scatter(Reflect::Span<const W>(objects), column) == 0);
+	}
+
+	void TestConstArguments()
+	{
+		const Reflect::Function *bump = Reflect::Resolve<W>()->GetMemberFunction("Bump(int&)");
+		const Reflect::Function *read = Reflect::Resolve<W>()->GetMemberFunction("Read");
+		Reflect::Any result;
+
+		const int constInt = 1;
+		const Reflect::Any constAny = 1;
+		int i = 1;
+
+		CHECK(!bump->InvokeInto(Reflect::AnyRef(), result, constInt));
+		CHECK(!bump->InvokeInto(Reflect::AnyRef(), result, constAny));
+		CHECK(constInt == 1 && *constAny.TryCast<int>() == 1);
+		CHECK(bump->InvokeInto(Reflect::AnyRef(), result, i));
+		CHECK(i == 2);
+
+		CHECK(read->InvokeInto(Reflect::AnyRef(), result, constInt));  // a const reference parameter binds a const argument
+		CHECK(*result.TryCast<int>() == 1);
+
+		int count = 0;
+
+		CHECK(!Reflect::Resolve<Counter>()->GetConstructor<int&>()->NewInstance(constInt));
+		CHECK(Reflect::Resolve<Counter>()->GetConstructor<int&>()->NewInstance(count));
+		CHECK(count == 1);
+	}
+
+	void TestConstBatches()
+	{
+		const Reflect::Function *addTo = Reflect::Resolve<W>()->GetMemberFunction("AddTo");
+		const Reflect::Function *bump = Reflect::Resolve<W>()->GetMemberFunction("Bump");
+
+		const W constObjects[3];
+		W objects[3];
+
+		const int constTotal = 0;
+		int total = 0;
+
+		CHECK(addTo->InvokeBatch(Reflect::Span<const W>(constObjects), {}, constTotal) == 0);
+		CHECK(addTo->InvokeBatch(Reflect::Span<const W>(constObjects), {}, total) == 3);
+		CHECK(total == 3);
+
+		CHECK(bump->InvokeBatch(Reflect::Span<const W>(constObjects), {}) == 0);
+		CHECK(bump->InvokeBatch(Reflect::Span<W>(objects), {}) == 3);
+		CHECK(objects[0].value == 2 && constObjects[0].value == 1);
+
+		Reflect::AnyRef refs[2] = { Reflect::AnyRef(constObjects[0]), Reflect::AnyRef(objects[0]) };
+
+		CHECK(bump->InvokeBatch(Reflect::Span<Reflect::AnyRef>(refs), {}) == 1);  // the const view is skipped
+		CHECK(constObjects[0].value == 1 && objects[0].value == 3);
+	}
+
+	// a T&& parameter takes the argument as an rvalue (const arguments aren't bound to it), batches pass it a copy of each argument
+	void TestRvalueReferenceArguments()
+	{
+		const Reflect::Function *consume = Reflect::Resolve<W>()->GetMemberFunction("Consume");
+		const Reflect::Function *rename = Reflect::Resolve<Owner>()->GetMemberFunction("Rename");
+		Reflect::Any result;
+
+		std::string text(100, 'x');
+		const std::string constText(100, 'y');
+
+		CHECK(consume->InvokeInto(Reflect::AnyRef(), result, text));
+		CHECK(*result.TryCast<std::size_t>() == 100 && text.empty());  // moved from by the function
+		CHECK(!consume->InvokeInto(Reflect::AnyRef(), result, constText));
+		CHECK(constText == std::string(100, 'y'));
+
+		Owner owner;
+
+		CHECK(rename->InvokeInto(owner, result, std::string("renamed")));
+		CHECK(owner.name == "renamed");
+
+		Reflect::Any instance = Reflect::Resolve<Owner>()->GetConstructor<std::string>()->NewInstance(std::string("constructed"));
+
+		CHECK(instance.TryCast<Owner>() && instance.TryCast<Owner>()->name == "constructed");
+
+		Owner owners[3];
+		std::string shared(100, 'z');
+
+		CHECK(rename->InvokeBatch(Reflect::Span<Owner>(owners), {}, shared) == 3);
+		CHECK(shared == std::string(100, 'z'));
+
+		for (const Owner &each : owners)
+			CHECK(each.name == shared);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<W>("W")
+		.AddDataMember(&W::value, "value")
+		.AddDataMember<&W::SetValue, &W::GetValue>("property")
+		.AddMemberFunction(&W::Bump, "Bump")
+		.AddMemberFunction(&W::Value, "Value")
+		.AddMemberFunction(&W::AddTo, "AddTo")
+		.AddMemberFunction(&Bump, "Bump(int&)")
+		.AddMemberFunction(&Read, "Read")
+		.AddMemberFunction(&Consume, "Consume");
+	Reflect::Reflect<Counter>("Counter").AddConstructor<int&>();
+	Reflect::Reflect<std::size_t>("size_t");
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Owner>("Owner")
+		.AddConstructor<std::string&&>()
+		.AddMemberFunction(&Owner::Rename, "Rename");
+
+	TestConstViews();
+	TestConstObjectInvoke();
+	TestConstObjectDataMembers();
+	TestConstArguments();
+	TestConstBatches();
+	TestRvalueReferenceArguments();
+}
@@ -0,0 +1,246 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <cstddef>
+#include <string>
+
+namespace
+{
+
+	struct Counted
+	{
+		static inline int sCopies = 0;
+		static inline int sMoves = 0;
+
+		Counted() = default;
+		Counted(const Counted&) { ++sCopies; }
+		Counted(Counted&&) noexcept { ++sMoves; }
+		Counted &operator=(const Counted&) { ++sCopies; return *this; }
+		Counted &operator=(Counted&&) noexcept { ++sMoves; return *this; }
+
+		static void ResetCounts() { sCopies = 0; sMoves = 0; }
+	};
+
+	struct Holder
+	{
+		Counted field;
+		Counted property;
+		Counted sink;
+
+		const Counted &GetProperty() const { return property; }
+		void SetProperty(Counted value) { property = std::move(value); }
+
+		const Counted &GetSink() const { return sink; }
+		void SetSink(Counted &&value) { sink = std::move(value); }  // only takes rvalues
+	};
+
+	struct Pad { char pad[24] = {}; };
+
+	struct Point
+	{
+		int x = 1;
+		double y = 2.0;
+		const int id = 3;
+		int z = 4;
+
+		int GetZ() const { return z; }
+		void SetZ(int value) { z = value; }
+	};
+
+	struct Derived : Pad, Point {};  // Point at a non zero offset
+
+	std::size_t GetPointOffset()
+	{
+		Derived derived;
+
+		return reinterpret_cast<char*>(static_cast<Point*>(&derived)) - reinterpret_cast<char*>(&derived);
+	}
+
+	void TestOffsets()
+	{
+		const Reflect::TypeDescriptor *point = Reflect::Resolve<Point>();
+
+		CHECK(point->GetDataMember("x")->GetOffset() == offsetof(Point, x));
+		CHECK(point->GetDataMember("y")->GetOffset() == offsetof(Point, y));
+		CHECK(point->GetDataMember("id")->GetOffset() == offsetof(Point, id));
+		CHECK(point->GetDataMember("y")->GetOffset(Reflect::Resolve<Derived>()) == GetPointOffset() + offsetof(Point, y));
+		CHECK(point->GetDataMember("z")->GetOffset() == Reflect::DataMember::NO_OFFSET);  // setter and getter
+		CHECK(point->GetDataMember("y")->GetOffset(Reflect::Resolve<Holder>()) == Reflect::DataMember::NO_OFFSET);  // unrelated type
+	}
+
+	void TestAccessors()
+	{
+		const Reflect::TypeDescriptor *point = Reflect::Resolve<Point>();
+		Point p;
+		Derived d;
+
+		Reflect::FieldAccessor<double> y = point->GetDataMember("y")->Accessor<double>();
+
+		CHECK(y && y.GetOffset() == offsetof(Point, y));
+		CHECK(y.Get(&p) == 2.0);
+		y.Set(&p, 5.0);
+		CHECK(p.y == 5.0);
+
+		Reflect::FieldAccessor<double> derivedY = point->GetDataMember("y")->Accessor<double>(Reflect::Resolve<Derived>());
+
+		derivedY.Set(&d, 6.0);
+		CHECK(d.y == 6.0 && derivedY.Get(static_cast<const void*>(&d)) == 6.0);
+
+		CHECK(!point->GetDataMember("x")->Accessor<double>());  // wrong type
+		CHECK(!point->GetDataMember("id")->Accessor<int>());    // read only
+		CHECK(point->GetDataMember("id")->Accessor<const int>().Get(&p) == 3);
+		CHECK(!point->GetDataMember("z")->Accessor<int>());     // no fixed offset
+	}
+
+	void TestSuccessStatus()
+	{
+		const Reflect::DataMember *x = Reflect::Resolve<Point>()->GetDataMember("x");
+		Point point;
+		Derived derived;
+		Reflect::Any value;
+
+		CHECK(x->TryGet(point, value) == Reflect::AccessStatus::Success && *value.TryCast<int>() == 1);
+		CHECK(x->TrySet(point, Reflect::Any(5)) == Reflect::AccessStatus::Success && point.x == 5);
+		CHECK(x->TrySet(derived, Reflect::Any(6)) == Reflect::AccessStatus::Success && derived.x == 6);  // through a base
+	}
+
+	void TestBadObjectStatus()
+	{
+		const Reflect::DataMember *x = Reflect::Resolve<Point>()->GetDataMember("x");
+		Holder holder;
+		Reflect::Any value;
+
+		CHECK(x->TryGet(holder, value) == Reflect::AccessStatus::BadObject);
+		CHECK(x->TryGet(Reflect::AnyRef(), value) == Reflect::AccessStatus::BadObject);
+		CHECK(x->TrySet(holder, Reflect::Any(5)) == Reflect::AccessStatus::BadObject);
+	}
+
+	void TestBadValueStatus()
+	{
+		const Reflect::DataMember *x = Reflect::Resolve<Point>()->GetDataMember("x");
+		Point point;
+
+		CHECK(x->TrySet(point, Reflect::Any(std::string("five"))) == Reflect::AccessStatus::BadValue);
+		CHECK(x->TrySet(point, Reflect::Any()) == Reflect::AccessStatus::BadValue);
+		CHECK(point.x == 1);
+	}
+
+	void TestReadOnlyStatus()
+	{
+		const Reflect::DataMember *id = Reflect::Resolve<Point>()->GetDataMember("id");
+		Point point;
+		Reflect::Any value;
+
+		CHECK(id->TrySet(point, Reflect::Any(7)) == Reflect::AccessStatus::ReadOnly && point.id == 3);
+		CHECK(id->TryGet(point, value) == Reflect::AccessStatus::Success && *value.TryCast<int>() == 3);  // read only data members can be read
+	}
+
+	bool Contains(const char *text, const std::string &name)
+	{
+		return std::string(text).find(name) != std::string::npos;
+	}
+
+	// the message of a BadCastException names the expected and the actual types
+	void TestBadCastMessage()
+	{
+		const Reflect::DataMember *x = Reflect::Resolve<Point>()->GetDataMember("x");
+		Point point;
+		Holder holder;
+		bool isThrown = false;
+
+		try
+		{
+			x->Set(point, Reflect::Any(std::string("five")));
+		}
+		catch (const Reflect::BadCastException &exception)
+		{
+			isThrown = true;
+			CHECK(exception.GetRetrievedType() == Reflect::Resolve<int>() && exception.GetContainedType() == Reflect::Resolve<std::string>());
+			CHECK(Contains(exception.what(), "int") && Contains(exception.what(), "string"));
+		}
+
+		CHECK(isThrown);
+		isThrown = false;
+
+		try
+		{
+			x->Get(holder);
+		}
+		catch (const Reflect::BadCastException &exception)
+		{
+			isThrown = true;
+			CHECK(Contains(exception.what(), "Point") && Contains(exception.what(), "Holder"));
+		}
+
+		CHECK(isThrown);
+	}
+
+	void TestRvalueIsMoved()
+	{
+		Holder holder;
+
+		for (const char *name : { "field", "property", "sink" })
+		{
+			Reflect::Any value = Counted();
+			Counted::ResetCounts();
+
+			Reflect::Resolve<Holder>()->GetDataMember(name)->Set(holder, std::move(value));
+			CHECK(Counted::sCopies == 0);
+		}
+	}
+
+	void TestLvalueIsCopied()
+	{
+		Holder holder;
+		Reflect::Any value = Counted();
+
+		Counted::ResetCounts();
+		Reflect::Resolve<Holder>()->GetDataMember("field")->Set(holder, value);
+		CHECK(Counted::sCopies == 1 && Counted::sMoves == 0);
+
+		Counted::ResetCounts();
+		Reflect::Resolve<Holder>()->GetDataMember("sink")->Set(holder, value);  // a copy is passed to the setter
+		CHECK(Counted::sCopies == 1);
+		CHECK(value.TryCast<Counted>());
+	}
+
+	void TestReferencedObjectIsCopied()
+	{
+		Holder holder;
+		Counted counted;
+
+		Counted::ResetCounts();
+		Reflect::Resolve<Holder>()->GetDataMember("field")->Set(holder, Reflect::Any(Reflect::AnyRef(counted)));  // not owned by the Any
+		CHECK(Counted::sCopies == 1 && Counted::sMoves == 0);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<Counted>("Counted");
+	Reflect::Reflect<Holder>("Holder")
+		.AddDataMember(&Holder::field, "field")
+		.AddDataMember<&Holder::SetProperty, &Holder::GetProperty>("property")
+		.AddDataMember<&Holder::SetSink, &Holder::GetSink>("sink");
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<double>("double");
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Pad>("Pad");
+	Reflect::Reflect<Point>("Point")
+		.AddDataMember(&Point::x, "x")
+		.AddDataMember(&Point::y, "y")
+		.AddDataMember(&Point::id, "id")
+		.AddDataMember<&Point::SetZ, &Point::GetZ>("z");
+	Reflect::Reflect<Derived>("Derived").AddBase<Pad>().AddBase<Point>();
+
+	TestRvalueIsMoved();
+	TestLvalueIsCopied();
+	TestReferencedObjectIsCopied();
+	TestOffsets();
+	TestAccessors();
+	TestSuccessStatus();
+	TestBadObjectStatus();
+	TestBadValueStatus();
+	TestReadOnlyStatus();
+	TestBadCastMessage();
+}
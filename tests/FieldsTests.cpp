@@ -0,0 +1,112 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+
+	struct Vec3
+	{
+		float x = 0.0f;
+		float y = 0.0f;
+		float z = 0.0f;
+	};
+
+	struct Named
+	{
+		std::string name;
+		int id = 0;
+	};
+
+}  // namespace
+
+// declared once, used by ForEachField and by TypeFactory::AddFields
+template <>
+struct Reflect::FieldList<Vec3>
+{
+	static constexpr auto Fields = Reflect::MakeFields(Reflect::MakeField("x", &Vec3::x), Reflect::MakeField("y", &Vec3::y), Reflect::MakeField("z", &Vec3::z));
+};
+
+template <>
+struct Reflect::FieldList<Named>
+{
+	static constexpr auto Fields = Reflect::MakeFields(Reflect::MakeField("name", &Named::name), Reflect::MakeField("id", &Named::id));
+};
+
+namespace
+{
+
+	constexpr float Sum(const Vec3 &v)
+	{
+		float sum = 0.0f;
+
+		Reflect::ForEachField(v, [&sum](const char*, const float &field) { sum += field; });
+
+		return sum;
+	}
+
+	constexpr Vec3 Scaled(Vec3 v, float factor)
+	{
+		Reflect::ForEachField(v, [factor](const char*, float &field) { field *= factor; });
+
+		return v;
+	}
+
+	// the fields are visited with straight-line code, in constant expressions too
+	void TestForEachField()
+	{
+		static_assert(Reflect::GetFieldCount<Vec3>() == 3 && Reflect::GetFieldCount<Named>() == 2);
+		static_assert(Sum(Vec3{ 1.0f, 2.0f, 3.0f }) == 6.0f);
+		static_assert(Scaled(Vec3{ 1.0f, 2.0f, 3.0f }, 2.0f).z == 6.0f);
+
+		std::string names;
+		Named named{ "named", 7 };
+
+		Reflect::ForEachField(named, [&names](const char *name, const auto&) { names += std::string(name) + ' '; });
+		CHECK(names == "name id ");
+
+		Reflect::ForEachField(named, [](const char *name, auto &field)
+		{
+			if constexpr (std::is_same_v<std::decay_t<decltype(field)>, int>)
+				field = std::strcmp(name, "id") == 0 ? 8 : -1;
+		});
+
+		CHECK(named.id == 8 && named.name == "named");
+	}
+
+	// AddFields registers the same fields as data members, found by name
+	void TestAddFields()
+	{
+		const Reflect::TypeDescriptor *vec3 = Reflect::Resolve<Vec3>();
+		const Reflect::TypeDescriptor *named = Reflect::Resolve<Named>();
+		const Vec3 v;
+
+		Reflect::ForEachField(v, [vec3](const char *name, const auto&) { CHECK(vec3->GetDataMember(name)); });
+		CHECK(named->GetDataMember("name") && named->GetDataMember("id") && !named->GetDataMember("x"));
+
+		CHECK(vec3->GetDataMember("y")->GetOffset() == offsetof(Vec3, y));
+
+		Named object;
+
+		named->GetDataMember("id")->Set(object, Reflect::Any(5));
+		named->GetDataMember("name")->Set(object, Reflect::Any(std::string("set")));
+		CHECK(object.id == 5 && object.name == "set");
+		CHECK(*named->GetDataMember("id")->Get(object).TryCast<int>() == 5);
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<float>("float");
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Vec3>("Vec3").AddFields();
+	Reflect::Reflect<Named>("Named").AddFields();
+
+	TestForEachField();
+	TestAddFields();
+}
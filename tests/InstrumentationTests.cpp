@@ -0,0 +1,108 @@
+#include "Reflect.hpp"  // built with REFLECT_INSTRUMENTATION
+#include "Check.hpp"
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+	struct Counter
+	{
+		int total = 0;
+
+		int Add(int value) { return total += value; }
+		std::string Describe() const { return "a description long enough to be heap allocated"; }
+	};
+
+	constexpr int THREADS = 4;
+	constexpr int CALLS = 100;
+
+	// each thread calls with an int, a converted double, a bad argument, and gets back an object that spills to the heap
+	void CallFromThread()
+	{
+		const Reflect::TypeDescriptor *type = Reflect::Resolve<Counter>();
+		Counter counter;
+		Reflect::Any result;
+
+		for (int i = 0; i < CALLS; ++i)
+		{
+			CHECK(type->GetMemberFunction("Add")->InvokeInto(counter, result, 1));
+			CHECK(type->GetMemberFunction("Add")->InvokeInto(counter, result, 1.0));
+			CHECK(!type->GetMemberFunction("Add")->InvokeInto(counter, result, std::string("one")));
+			CHECK(type->GetMemberFunction("Describe")->InvokeInto(counter, result));
+		}
+
+		CHECK(counter.total == 2 * CALLS);
+	}
+
+	const Reflect::CallStats *FindStats(const std::vector<Reflect::MetaObjectStats> &stats, const std::string &description)
+	{
+		for (const Reflect::MetaObjectStats &metaObject : stats)
+			if (metaObject.TypeName == "Counter" && metaObject.Kind == "function" && metaObject.Description == description)
+				return &metaObject.Stats;
+
+		return nullptr;
+	}
+
+	// the counts of the threads are aggregated, they survive the threads
+	void TestCallsFromThreads()
+	{
+		std::vector<std::thread> threads;
+
+		for (int i = 0; i < THREADS; ++i)
+			threads.emplace_back(CallFromThread);
+
+		for (std::thread &thread : threads)
+			thread.join();
+
+		std::vector<Reflect::MetaObjectStats> stats = Reflect::CollectStats();
+		const Reflect::CallStats *add = FindStats(stats, "Add");
+		const Reflect::CallStats *describe = FindStats(stats, "Describe");
+
+		CHECK(add && add->Calls == 3 * THREADS * CALLS);
+		CHECK(add->FailedCasts == THREADS * CALLS && add->Conversions == THREADS * CALLS && add->HeapSpills == 0);
+
+		CHECK(describe && describe->Calls == THREADS * CALLS);
+		CHECK(describe->FailedCasts == 0 && describe->HeapSpills == THREADS * CALLS);
+
+		std::uint64_t histogramCalls = 0;
+
+		for (std::uint64_t calls : add->Histogram)
+			histogramCalls += calls;
+
+		CHECK(histogramCalls == add->Calls);
+	}
+
+	// the stats are listed under the name of the type, each meta object by its kind and name
+	void TestDumpStats()
+	{
+		std::ostringstream os;
+
+		Reflect::DumpStats(os);
+
+		std::string dump = os.str();
+		std::string counts = std::to_string(THREADS * CALLS);
+
+		CHECK(dump.find("Counter\n") != std::string::npos);
+		CHECK(dump.find("  function Add: " + std::to_string(3 * THREADS * CALLS) + " calls, " + counts + " failed casts, " + counts + " conversions, 0 heap spills") != std::string::npos);
+		CHECK(dump.find("  function Describe: " + counts + " calls, 0 failed casts, 0 conversions, " + counts + " heap spills") != std::string::npos);
+		CHECK(dump.find("  conversion ") != std::string::npos);  // double to int
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<double>("double").AddConversion<int>();
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Counter>("Counter")
+		.AddMemberFunction(&Counter::Add, "Add")
+		.AddMemberFunction(&Counter::Describe, "Describe");
+
+	TestCallsFromThreads();
+	TestDumpStats();
+}
@@ -0,0 +1,118 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <string>
+
+namespace
+{
+
+	struct Accumulator
+	{
+		int total = 0;
+
+		int Add(int value) { return total += value; }
+		int Get() const { return total; }
+	};
+
+	int Twice(int value) { return 2 * value; }
+
+	struct Range
+	{
+		int first, last;
+
+		Range(int first, int last) : first(first), last(last) {}
+	};
+
+	// an invoker is bound to the exact signature of the function and calls it through its thunk
+	void TestBind()
+	{
+		const Reflect::TypeDescriptor *type = Reflect::Resolve<Accumulator>();
+
+		Reflect::Invoker<int(Accumulator&, int)> add = type->GetMemberFunction("Add")->Bind<int(Accumulator&, int)>();
+		Reflect::Invoker<int(const Accumulator&)> get = type->GetMemberFunction("Get")->Bind<int(const Accumulator&)>();
+		Reflect::Invoker<int(int)> twice = type->GetMemberFunction("Twice")->Bind<int(int)>();
+
+		CHECK(add && get && twice);
+
+		Accumulator accumulator;
+		const Accumulator &constAccumulator = accumulator;
+
+		CHECK(add(accumulator, 3) == 3 && add(accumulator, 4) == 7);
+		CHECK(accumulator.total == 7);
+		CHECK(get(constAccumulator) == 7);
+		CHECK(twice(21) == 42);
+
+		Reflect::Any result;
+
+		CHECK(!type->GetMemberFunction("Add")->InvokeInto(constAccumulator, result, 1));  // rejected through a const object
+		CHECK(accumulator.total == 7);
+	}
+
+	void TestBindMismatch()
+	{
+		const Reflect::TypeDescriptor *type = Reflect::Resolve<Accumulator>();
+
+		CHECK(!type->GetMemberFunction("Add")->Bind<int(const Accumulator&, int)>());  // a non const member function isn't called through a const object
+		CHECK(!type->GetMemberFunction("Get")->Bind<int(Accumulator&)>());
+		CHECK(!type->GetMemberFunction("Twice")->Bind<long(int)>());
+		CHECK(!type->GetMemberFunction("Twice")->Bind<int(const int&)>());
+		CHECK(!Reflect::Invoker<int(int)>());
+	}
+
+	// arguments known at run time (i.e. the stack slots of a script VM) are passed as a span of views
+	void TestSpanArguments()
+	{
+		const Reflect::Function *add = Reflect::Resolve<Accumulator>()->GetMemberFunction("Add");
+		const Reflect::Function *twice = Reflect::Resolve<Accumulator>()->GetMemberFunction("Twice");
+		Accumulator accumulator;
+		int value = 5;
+		double converted = 2.0;
+
+		Reflect::AnyRef one[] = { Reflect::AnyRef(value) };
+		Reflect::AnyRef two[] = { Reflect::AnyRef(value), Reflect::AnyRef(value) };
+		Reflect::AnyRef convertedOne[] = { Reflect::AnyRef(converted) };
+
+		CHECK(*add->Invoke(accumulator, Reflect::Span<Reflect::AnyRef>(one)).TryCast<int>() == 5);
+		CHECK(*twice->Invoke(Reflect::AnyRef(), Reflect::Span<Reflect::AnyRef>(convertedOne)).TryCast<int>() == 4);
+
+		Reflect::Any result = 1;
+
+		CHECK(!add->InvokeInto(accumulator, result, Reflect::Span<Reflect::AnyRef>(two)) && !result);  // argument count mismatch
+		CHECK(!add->InvokeInto(accumulator, result, Reflect::Span<Reflect::AnyRef>()) && !result);
+		CHECK(accumulator.total == 5);
+	}
+
+	void TestSpanConstructorArguments()
+	{
+		const Reflect::Constructor *constructor = Reflect::Resolve<Range>()->GetConstructor<int, int>();
+		int first = 1;
+		double last = 9.0;
+		std::string text = "not an int";
+
+		Reflect::AnyRef args[] = { Reflect::AnyRef(first), Reflect::AnyRef(last) };
+		Reflect::AnyRef badArgs[] = { Reflect::AnyRef(first), Reflect::AnyRef(text) };
+
+		Reflect::Any range = constructor->NewInstance(Reflect::Span<Reflect::AnyRef>(args));
+
+		CHECK(range.TryCast<Range>() && range.TryCast<Range>()->first == 1 && range.TryCast<Range>()->last == 9);
+		CHECK(!constructor->NewInstance(Reflect::Span<Reflect::AnyRef>(args).subspan(0, 1)));  // argument count mismatch
+		CHECK(!constructor->NewInstance(Reflect::Span<Reflect::AnyRef>(badArgs)));
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<double>("double").AddConversion<int>();
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Range>("Range").AddConstructor<int, int>();
+	Reflect::Reflect<Accumulator>("Accumulator")
+		.AddMemberFunction(&Accumulator::Add, "Add")
+		.AddMemberFunction(&Accumulator::Get, "Get")
+		.AddMemberFunction(&Twice, "Twice");
+
+	TestBind();
+	TestBindMismatch();
+	TestSpanArguments();
+	TestSpanConstructorArguments();
+}
@@ -0,0 +1,112 @@
+#include "Parallel.hpp"  // must compile on its own
+#include "Check.hpp"
+#include <string>
+#include <vector>
+
+namespace
+{
+
+	struct Pad { char pad[24] = {}; };
+
+	struct P
+	{
+		int x = 0;
+		std::string name;
+
+		void Scale(int factor) { x *= factor; }
+		int Get() const { return x; }
+	};
+
+	struct Q : Pad, P {};  // P at a non zero offset
+
+	constexpr std::size_t COUNT = 1000;
+	constexpr std::size_t GRAIN_SIZE = 64;
+
+	void TestParallelInvoke(Reflect::ThreadPool &pool)
+	{
+		std::vector<P> objects(COUNT);
+		std::vector<Reflect::Any> results(COUNT);
+
+		for (std::size_t i = 0; i < COUNT; ++i)
+			objects[i].x = static_cast<int>(i);
+
+		const Reflect::Function &scale = *Reflect::Resolve<P>()->GetMemberFunction("Scale");
+		const Reflect::Function &get = *Reflect::Resolve<P>()->GetMemberFunction("Get");
+
+		CHECK(Reflect::ParallelInvoke(pool, GRAIN_SIZE, scale, Reflect::Span<P>(objects), {}, 2) == COUNT);
+		CHECK(Reflect::ParallelInvoke(pool, GRAIN_SIZE, get, Reflect::Span<P>(objects), Reflect::Span<Reflect::Any>(results)) == COUNT);
+
+		for (std::size_t i = 0; i < COUNT; ++i)
+			CHECK(*results[i].TryCast<int>() == static_cast<int>(2 * i));
+
+		std::vector<int> factors(COUNT, 3);
+
+		CHECK(Reflect::ParallelInvokeColumns(pool, GRAIN_SIZE, scale, Reflect::Span<P>(objects), {}, Reflect::Span<int>(factors)) == COUNT);
+		CHECK(objects[COUNT - 1].x == static_cast<int>(6 * (COUNT - 1)));
+	}
+
+	void TestParallelSet(Reflect::ThreadPool &pool)
+	{
+		std::vector<Q> objects(COUNT);
+		const Reflect::DataMember &x = *Reflect::Resolve<P>()->GetDataMember("x");
+		const Reflect::DataMember &name = *Reflect::Resolve<P>()->GetDataMember("name");
+
+		CHECK(Reflect::ParallelSet(pool, GRAIN_SIZE, x, Reflect::Span<Q>(objects), Reflect::Any(7)) == COUNT);
+		CHECK(Reflect::ParallelSet(pool, GRAIN_SIZE, name, Reflect::Span<Q>(objects), Reflect::Any(std::string("a name long enough to be heap allocated"))) == COUNT);
+
+		for (const Q &object : objects)
+			CHECK(object.x == 7 && object.name == "a name long enough to be heap allocated");
+
+		CHECK(Reflect::ParallelSet(pool, GRAIN_SIZE, x, Reflect::Span<Q>(objects), Reflect::Any(2.5)) == COUNT);  // converted once
+		CHECK(objects[0].x == 2 && objects[COUNT - 1].x == 2);
+
+		bool isThrown = false;
+
+		try
+		{
+			Reflect::ParallelSet(pool, GRAIN_SIZE, x, Reflect::Span<Q>(objects), Reflect::Any(std::string("not an int")));
+		}
+		catch (const Reflect::BadCastException&)
+		{
+			isThrown = true;
+		}
+
+		CHECK(isThrown);
+	}
+
+	void TestParallelSetColumn(Reflect::ThreadPool &pool)
+	{
+		std::vector<P> objects(COUNT);
+		std::vector<Reflect::Any> values(COUNT);
+		const Reflect::DataMember &x = *Reflect::Resolve<P>()->GetDataMember("x");
+
+		for (std::size_t i = 0; i < COUNT; ++i)
+			values[i] = i % 2 ? Reflect::Any(static_cast<int>(i)) : Reflect::Any(static_cast<double>(i));  // half of them are converted
+
+		CHECK(Reflect::ParallelSetColumn(pool, GRAIN_SIZE, x, Reflect::Span<P>(objects), Reflect::Span<const Reflect::Any>(values)) == COUNT);
+
+		for (std::size_t i = 0; i < COUNT; ++i)
+			CHECK(objects[i].x == static_cast<int>(i));
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<double>("double").AddConversion<int>();
+	Reflect::Reflect<std::string>("string");
+	Reflect::Reflect<Pad>("Pad");
+	Reflect::Reflect<P>("P")
+		.AddDataMember(&P::x, "x")
+		.AddDataMember(&P::name, "name")
+		.AddMemberFunction(&P::Scale, "Scale")
+		.AddMemberFunction(&P::Get, "Get");
+	Reflect::Reflect<Q>("Q").AddBase<Pad>().AddBase<P>();
+
+	Reflect::ThreadPool pool(4);
+
+	TestParallelInvoke(pool);
+	TestParallelSet(pool);
+	TestParallelSetColumn(pool);
+}
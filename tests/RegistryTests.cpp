@@ -0,0 +1,148 @@
+#include "Reflect.hpp"
+#include "Check.hpp"
+#include <cstdint>
+#include <string>
+#include <utility>
+
+namespace
+{
+
+	struct Foo {};
+
+	template <int N>
+	struct Numbered {};
+
+	template <int... N>
+	void RegisterNumbered(std::integer_sequence<int, N...>)
+	{
+		(Reflect::Reflect<Numbered<N>>("Numbered" + std::to_string(N)), ...);
+	}
+
+	void TestTypeIds()
+	{
+		static_assert(Reflect::GetTypeId<Foo>() == Reflect::GetTypeId<const Foo&>());  // computed at compile time, qualifiers stripped
+		static_assert(Reflect::GetTypeId<Foo>() != Reflect::GetTypeId<Foo*>());
+
+		CHECK(Reflect::Resolve<Foo>()->GetId() == Reflect::GetTypeId<Foo>());
+		CHECK(Reflect::Resolve(Reflect::GetTypeId<Foo>()) == Reflect::Resolve<Foo>());
+	}
+
+	void TestNames()
+	{
+		CHECK(Reflect::Resolve("Foo") == Reflect::Resolve<Foo>());
+		CHECK(Reflect::Resolve(Reflect::HashedName("Foo")) == Reflect::Resolve<Foo>());
+		CHECK(!Reflect::Resolve("Bar"));
+
+		Reflect::Reflect<Foo>("Renamed");  // the first name is kept
+
+		CHECK(Reflect::Resolve<Foo>()->GetName() == "Foo");
+		CHECK(Reflect::Resolve("Foo") == Reflect::Resolve<Foo>() && !Reflect::Resolve("Renamed"));
+	}
+
+	// the registry tables grow while keeping all the registered types
+	void TestGrowth()
+	{
+		RegisterNumbered(std::make_integer_sequence<int, 200>());
+
+		CHECK(Reflect::Resolve("Numbered0") == Reflect::Resolve<Numbered<0>>());
+		CHECK(Reflect::Resolve("Numbered199") == Reflect::Resolve<Numbered<199>>());
+		CHECK(Reflect::Resolve(Reflect::GetTypeId<Numbered<123>>()) == Reflect::Resolve<Numbered<123>>());
+		CHECK(Reflect::Resolve("Foo") == Reflect::Resolve<Foo>());
+	}
+
+	struct Named
+	{
+		std::string name;
+
+		const std::string &GetName() const { return name; }
+	};
+
+	// a name index finds objects by precomputed hash, the first of the objects with the same name is found
+	void TestNameIndex()
+	{
+		Named position{ "position" }, rotation{ "rotation" }, duplicate{ "position" };
+		Named *objects[] = { &position, &rotation, &duplicate };
+
+		Reflect::Details::NameIndex<Named> index;
+		index.Build(Reflect::Span<Named* const>(objects));
+
+		static constexpr Reflect::HashedName positionName("position");
+
+		CHECK(index.Find(positionName) == &position);
+		CHECK(index.Find(Reflect::HashedName("rotation")) == &rotation);
+		CHECK(!index.Find(Reflect::HashedName("scale")));
+		CHECK(!Reflect::Details::NameIndex<Named>().Find(positionName));  // never built
+	}
+
+	struct Entity
+	{
+		int health = 1;
+
+		int GetHealth() const { return health; }
+	};
+
+	struct Player : Entity
+	{
+		int health = 2;  // hides Entity::health
+		int score = 3;
+
+		int GetHealth() const { return health; }
+	};
+
+	// members are found by a hash computed at compile time, own members hide inherited members with the same name
+	void TestMemberLookupByHash()
+	{
+		static constexpr Reflect::HashedName health("health");
+		static constexpr Reflect::HashedName score("score");
+		static constexpr Reflect::HashedName getHealth("GetHealth");
+
+		const Reflect::TypeDescriptor *player = Reflect::Resolve<Player>();
+		Player object;
+
+		CHECK(player->GetDataMember(score) && player->GetDataMember(score) == player->GetDataMember("score"));
+		CHECK(!player->GetDataMember(Reflect::HashedName("missing")));
+
+		const Reflect::DataMember *playerHealth = player->GetDataMember(health);
+
+		CHECK(playerHealth && playerHealth->GetParent() == player && playerHealth == player->GetDataMember("health"));
+		CHECK(*playerHealth->Get(object).TryCast<int>() == 2);
+		CHECK(Reflect::Resolve<Entity>()->GetDataMember(health)->GetParent() == Reflect::Resolve<Entity>());
+		CHECK(player->GetDataMembers().size() == 3);  // the hidden data member is still listed
+
+		const Reflect::Function *playerGetHealth = player->GetMemberFunction(getHealth);
+
+		CHECK(playerGetHealth && playerGetHealth->GetParent() == player && playerGetHealth == player->GetMemberFunction("GetHealth"));
+		CHECK(*playerGetHealth->Invoke(object).TryCast<int>() == 2);
+	}
+
+	// an integer object resolves to its own type, not to a type id
+	void TestResolveInteger()
+	{
+		std::uint64_t id = Reflect::GetTypeId<Foo>().Value;
+
+		CHECK(Reflect::Resolve(id) == Reflect::Resolve<std::uint64_t>());
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<Foo>("Foo");
+	Reflect::Reflect<std::uint64_t>("uint64");
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<Entity>("Entity")
+		.AddDataMember(&Entity::health, "health")
+		.AddMemberFunction(&Entity::GetHealth, "GetHealth");
+	Reflect::Reflect<Player>("Player")
+		.AddBase<Entity>()
+		.AddDataMember(&Player::health, "health")
+		.AddDataMember(&Player::score, "score")
+		.AddMemberFunction(&Player::GetHealth, "GetHealth");
+
+	TestTypeIds();
+	TestNames();
+	TestGrowth();
+	TestResolveInteger();
+	TestNameIndex();
+	TestMemberLookupByHash();
+}
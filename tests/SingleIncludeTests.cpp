@@ -0,0 +1,31 @@
+#include "reflect.hpp"  // the single include only
+#include "Check.hpp"
+
+namespace
+{
+
+	struct A { int a = 1; };
+	struct B : A { int b = 2; };
+
+	int Sum(const B &b) { return b.a + b.b; }
+
+	void TestSingleInclude()
+	{
+		B b;
+		Reflect::Any any = Reflect::AnyRef(b);
+
+		CHECK(any.TryCast<A>() == static_cast<A*>(&b));
+		CHECK(*Reflect::Resolve<B>()->GetMemberFunction("Sum")->Invoke(Reflect::AnyRef(), b).TryCast<int>() == 3);
+		CHECK(Reflect::Resolve("B") == Reflect::Resolve<B>());
+	}
+
+}  // namespace
+
+int main()
+{
+	Reflect::Reflect<int>("int");
+	Reflect::Reflect<A>("A").AddDataMember(&A::a, "a");
+	Reflect::Reflect<B>("B").AddBase<A>().AddDataMember(&B::b, "b").AddMemberFunction(&Sum, "Sum");
+
+	TestSingleInclude();
+}
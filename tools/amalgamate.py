@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""
+Generates the single include headers from the headers in reflect/: each local header is
+inlined where it's first included (later includes are dropped, as their include guards would),
+standard headers are kept as they are.
+
+usage: amalgamate.py [--check]  (--check fails if the single include headers are out of date)
+"""
+
+import os
+import re
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SOURCE_DIR = os.path.join(ROOT, "reflect")
+OUTPUT_DIR = os.path.join(ROOT, "single include")
+
+LOCAL_INCLUDE = re.compile(r'^\s*#\s*include\s+"([^"]+)"')
+NOTICE = "// generated by tools/amalgamate.py from the headers in reflect/, don't edit\n"
+
+
+def inline(name, included, lines):
+    if name in included:
+        return
+
+    included.add(name)
+
+    with open(os.path.join(SOURCE_DIR, name), newline="") as header:
+        for line in header:
+            match = LOCAL_INCLUDE.match(line)
+
+            if match:
+                inline(match.group(1), included, lines)
+            else:
+                lines.append(line)
+
+    if lines and not lines[-1].endswith("\n"):
+        lines[-1] += "\n"
+
+
+def generate():
+    lines = []
+    included = set()
+
+    for name in ("Reflect.hpp", "Parallel.hpp"):
+        inline(name, included, lines)
+
+    reflect = NOTICE + "#ifndef REFLECT_SINGLE_INCLUDE_H\n#define REFLECT_SINGLE_INCLUDE_H\n\n" + "".join(lines) + "\n#endif  // REFLECT_SINGLE_INCLUDE_H\n"
+    meta_any = NOTICE + "// Any depends on the type descriptors, it's part of the single include\n#include \"reflect.hpp\"\n"
+
+    return { "reflect.hpp": reflect, "meta_any.hpp": meta_any }
+
+
+def main():
+    check = "--check" in sys.argv[1:]
+    outdated = []
+
+    for name, content in generate().items():
+        path = os.path.join(OUTPUT_DIR, name)
+
+        if check:
+            with open(path, newline="") as current:
+                if current.read() != content:
+                    outdated.append(name)
+        else:
+            with open(path, "w", newline="") as output:
+                output.write(content)
+
+    if outdated:
+        print("out of date (run tools/amalgamate.py): " + ", ".join(outdated), file=sys.stderr)
+        return 1
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())